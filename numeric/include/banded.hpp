@@ -0,0 +1,168 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "view.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib banded declaration file
+ *
+ * Base class: band_matrix (n x n, kl subdiagonals, ku superdiagonals)
+ * Inner type: T (floating or complex)
+ *
+ * Declared types:
+ *      bandmatr32f_t =  { float32_t }
+ *      bandmatr64f_t =  { float64_t }
+ *      bandmatr128f_t = { float128_t }
+ *
+ *      bandmatr64c_t =  { complex64_t }
+ *      bandmatr128c_t = { complex128_t }
+ *      bandmatr256c_t = { complex256_t }
+ *
+ * LAPACK band storage: 'band' has kl + ku + 1 rows and n columns,
+ *      A(i, j) = band(ku + i - j, j),	-kl <= j - i <= ku
+ * so every diagonal is one contiguous row of 'band', memory and work
+ * are O(n * (kl + ku + 1)). 'multidiagonal' returns this type:
+ *
+ *      auto A = nm::multidiagonal<float64_t>(n, {{-1, 1.0}, {0, -2.0}, {1, 1.0}});
+ *      auto y = A * x;				// O(n * bandwidth), threaded
+ *      auto z = A.solve(b);			// O(n) for tridiagonal A
+ *
+ * Solvers:
+ *      thomas			- tridiagonal, no pivoting, O(n); used by 'solve' when A
+ *						  is tridiagonal and diagonally dominant
+ *      band_lu_base	- partial pivoting, O(n * kl * (kl + ku)); the factor
+ *						  has kl + ku superdiagonals, fill-in of the row swaps
+ *
+ * To solve the same A many times keep the factorization object:
+ * 'auto f = A.lu(); f.solve(b);', every solve is O(n * (2 kl + ku)).
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T> struct band_lu_base;
+
+		template <typename T>
+		struct band_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value || typing::is_complex<T>::value,
+				"template instantiation of band matrix must be floating or complex!"
+				);
+
+			band_matrix(uint128_t n = 0, uint128_t kl = 0, uint128_t ku = 0);
+			band_matrix(const matrix_base<T>& matr, uint128_t kl, uint128_t ku);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+			uint128_t lower_bandwidth() const;
+			uint128_t upper_bandwidth() const;
+			bool is_tridiagonal() const;
+			bool is_diagonally_dominant() const;
+
+			T& operator ()(uint128_t i, uint128_t j);				// (i, j) must be inside the band
+			T operator ()(uint128_t i, uint128_t j) const;		// zero outside the band
+
+			vector_view<T> diagonal(int32_t index = 0);
+			vector_view<const T> diagonal(int32_t index = 0) const;
+
+			band_matrix& fill_diagonal(T value, int32_t index = 0);
+			band_matrix& fill_diagonal(const vector_base<T>& values, int32_t index = 0);
+
+			matrix_base<T> dense() const;
+			operator matrix_base<T>() const;
+
+			template <typename V> auto operator *(const vector_base<V>& vec) const;
+
+			band_lu_base<T> lu() const;
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			using value_type = T;
+
+			matrix_base<T> band;		// (kl + ku + 1) x n, diagonal j - i = d in row ku - d
+			uint128_t kl;
+			uint128_t ku;
+		};
+
+		template <typename T>
+		struct band_lu_base
+		{
+			band_lu_base(const band_matrix<T>& matr);
+
+			uint128_t size() const;
+			bool is_singular() const;
+
+			T det() const;
+
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			vector_base<T>& solve_inplace(vector_base<T>& b) const;
+			matrix_base<T>& solve_inplace(matrix_base<T>& b) const;
+
+			matrix_base<T> lu;				// (2 kl + ku + 1) x n: U with kl + ku superdiagonals, multipliers of L below
+			std::vector<uint128_t> perm;	// row j was swapped with row perm[j] at step j
+			uint128_t kl;
+			uint128_t ku;
+			int32_t sign;
+			bool singular;
+		};
+	}
+
+	typedef base_type::band_matrix<float32_t>		bandmatr32f_t;
+	typedef base_type::band_matrix<float64_t>		bandmatr64f_t;
+	typedef base_type::band_matrix<float128_t>		bandmatr128f_t;
+
+	typedef base_type::band_matrix<complex64_t>		bandmatr64c_t;
+	typedef base_type::band_matrix<complex128_t>	bandmatr128c_t;
+	typedef base_type::band_matrix<complex256_t>	bandmatr256c_t;
+
+	#ifdef BASIC_COMP_TYPE_FLOAT32
+	typedef bandmatr32f_t bandmatrf_t;
+	typedef bandmatr64c_t bandmatrc_t;
+	#endif
+	#ifdef BASIC_COMP_TYPE_FLOAT64
+	typedef bandmatr64f_t bandmatrf_t;
+	typedef bandmatr128c_t bandmatrc_t;
+	#endif
+	#ifdef BASIC_COMP_TYPE_FLOAT128
+	typedef bandmatr128f_t bandmatrf_t;
+	typedef bandmatr256c_t bandmatrc_t;
+	#endif
+
+	template <typename T> base_type::band_matrix<T> multidiagonal(
+		const uint128_t& n,
+		const std::initializer_list<std::pair<int32_t, T>>& values);
+
+	// diagonal k holds n - |k| values, from its top left end
+	template <typename T> base_type::band_matrix<T> multidiagonal(
+		const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& diagonals);
+
+	template <typename T> base_type::band_lu_base<T> lu(const base_type::band_matrix<T>& matr);
+
+	template <typename T> base_type::vector_base<T> solve(
+		const base_type::band_matrix<T>& matr,
+		const base_type::vector_base<T>& b);
+
+	template <typename T> base_type::matrix_base<T> solve(
+		const base_type::band_matrix<T>& matr,
+		const base_type::matrix_base<T>& b);
+
+	// tridiagonal system: lower[i] = A(i + 1, i), diag[i] = A(i, i), upper[i] = A(i, i + 1)
+	template <typename T> base_type::vector_base<T> thomas(
+		const base_type::vector_base<T>& lower,
+		const base_type::vector_base<T>& diag,
+		const base_type::vector_base<T>& upper,
+		const base_type::vector_base<T>& b);
+}
+
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::band_matrix<T>& matrix);
+
+#include "../lib/banded.inl"
@@ -0,0 +1,174 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+#include "vector.hpp"
+#include "fixed.hpp"
+#include "parallel.hpp"
+#include "memory.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib batched declaration file
+ *
+ * Base class: batch_vector<T, N>, batch_matrix<T, M, N>
+ * Inner type: T (any)
+ *
+ * Declared types:
+ *      batchvect{2,3,4}_32f_t, batchvect{2,3,4}_64f_t	= batches of 2, 3, 4-vectors
+ *      batchmatr{2,3,4}_32f_t, batchmatr{2,3,4}_64f_t	= batches of 2 x 2, 3 x 3, 4 x 4 matrices
+ *
+ * A batch holds 'count' independent small fixed-size objects in
+ * structure-of-arrays layout: element (i, j) of every matrix in the
+ * batch is stored contiguously ('plane(i, j)'), i.e. base[(i * N + j) * count + b].
+ * The planes are 'memory::vector' storage, aligned to cache lines.
+ * 'det', 'inversed', 'solve' and 'cross' are straight-line closed forms
+ * (the ones of 'fixed.hpp' for N <= 4), they and the products are written
+ * against the planes directly, plane[k * count + b], with '__restrict' operands: every
+ * access is unit-stride across members and nothing is gathered, so the
+ * member loop vectorizes, one member per SIMD lane. The batch is walked in
+ * tiles of BATCH_TILE members, full tiles have a constant trip count that
+ * -O2 vectorizes as well. Tiles are split between the workers of
+ * 'parallel.hpp'. Other sizes fall back to the fixed_matrix operation per
+ * member.
+ *
+ *      nm::batchmatr3_64f_t K(1000000);	// element stiffness matrices
+ *      nm::batchvect3_64f_t f(1000000);
+ *      auto u = K.solve(f);				// one 3 x 3 solve per element
+ *      auto d = K.det();					// vector_base<float64_t> of size 1000000
+ *
+ * 'operator []' / 'set' move a single object between layouts, the
+ * constructor from std::vector of fixed objects and 'unpacked' convert
+ * the whole batch.
+ *
+/***********************************************************************/
+
+// member loops store to several planes of one buffer: the planes never
+// overlap, so the compiler may drop its run-time alias checks
+#if defined(__clang__)
+#define NUMERIC_BATCH_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define NUMERIC_BATCH_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define NUMERIC_BATCH_LOOP __pragma(loop(ivdep))
+#else
+#define NUMERIC_BATCH_LOOP
+#endif
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T, uint128_t N>
+		struct batch_vector
+		{
+			using value_type = fixed_vector<T, N>;
+
+			batch_vector(uint128_t count = 0);
+			batch_vector(uint128_t count, const value_type& value);
+			batch_vector(const std::vector<value_type>& vects);
+
+			uint128_t size() const;
+
+			value_type operator [](uint128_t b) const;
+			batch_vector& set(uint128_t b, const value_type& value);
+			std::vector<value_type> unpacked() const;
+
+			T* plane(uint128_t i);
+			const T* plane(uint128_t i) const;
+
+			vector_base<T> dot(const batch_vector& oth) const;
+			batch_vector cross(const batch_vector& oth) const;		// N = 3 only
+			vector_base<T> norm2() const;
+
+			batch_vector& operator +=(const batch_vector& oth);
+			batch_vector& operator -=(const batch_vector& oth);
+			batch_vector& operator *=(const T& value);
+
+			batch_vector operator +(const batch_vector& oth) const;
+			batch_vector operator -(const batch_vector& oth) const;
+			batch_vector operator *(const T& value) const;
+
+			uint128_t count;
+			memory::vector<T> base;			// plane i starts at i * count
+		};
+
+		template <typename T, uint128_t M, uint128_t N>
+		struct batch_matrix
+		{
+			using value_type = fixed_matrix<T, M, N>;
+
+			batch_matrix(uint128_t count = 0);
+			batch_matrix(uint128_t count, const value_type& value);
+			batch_matrix(const std::vector<value_type>& matrs);
+
+			uint128_t size() const;
+
+			value_type operator [](uint128_t b) const;
+			batch_matrix& set(uint128_t b, const value_type& value);
+			std::vector<value_type> unpacked() const;
+
+			T* plane(uint128_t i, uint128_t j);
+			const T* plane(uint128_t i, uint128_t j) const;
+
+			batch_matrix<T, N, M> transposed() const;
+			vector_base<T> det() const;
+			batch_matrix inversed() const;
+			batch_vector<T, M> solve(const batch_vector<T, M>& rhs) const;
+
+			batch_matrix& operator +=(const batch_matrix& oth);
+			batch_matrix& operator -=(const batch_matrix& oth);
+			batch_matrix& operator *=(const T& value);
+
+			batch_matrix operator +(const batch_matrix& oth) const;
+			batch_matrix operator -(const batch_matrix& oth) const;
+			batch_matrix operator *(const T& value) const;
+
+			template <uint128_t K> batch_matrix<T, M, K> operator *(const batch_matrix<T, N, K>& oth) const;
+			batch_vector<T, M> operator *(const batch_vector<T, N>& vect) const;
+
+			uint128_t count;
+			memory::vector<T> base;			// plane (i, j) starts at (i * N + j) * count
+		};
+	}
+
+	typedef base_type::batch_vector<float32_t, 2>	batchvect2_32f_t;
+	typedef base_type::batch_vector<float32_t, 3>	batchvect3_32f_t;
+	typedef base_type::batch_vector<float32_t, 4>	batchvect4_32f_t;
+	typedef base_type::batch_vector<float64_t, 2>	batchvect2_64f_t;
+	typedef base_type::batch_vector<float64_t, 3>	batchvect3_64f_t;
+	typedef base_type::batch_vector<float64_t, 4>	batchvect4_64f_t;
+
+	typedef base_type::batch_matrix<float32_t, 2, 2>	batchmatr2_32f_t;
+	typedef base_type::batch_matrix<float32_t, 3, 3>	batchmatr3_32f_t;
+	typedef base_type::batch_matrix<float32_t, 4, 4>	batchmatr4_32f_t;
+	typedef base_type::batch_matrix<float64_t, 2, 2>	batchmatr2_64f_t;
+	typedef base_type::batch_matrix<float64_t, 3, 3>	batchmatr3_64f_t;
+	typedef base_type::batch_matrix<float64_t, 4, 4>	batchmatr4_64f_t;
+
+	namespace kernel
+	{
+		// batch members per tile, the trip count of the member loops
+		constexpr uint128_t BATCH_TILE = 64;
+
+		// element count of a batched shape: T, fixed_vector or fixed_matrix
+		template <typename F> struct batch_traits;
+
+		// one object <-> member b of a batch with planes 'stride' apart
+		template <typename F, typename T> F batch_load(const T* p, uint128_t stride, uint128_t b);
+		template <typename F, typename T> void batch_store(const F& value, T* p, uint128_t stride, uint128_t b);
+
+		// runs body(b0, w) over tiles of w members from b0, 'cost' - operations per member,
+		// w of a full tile is std::integral_constant<uint128_t, BATCH_TILE>
+		template <typename F> void batch_for(uint128_t count, uint128_t cost, F&& body);
+
+		// closed forms over the planes of w members, operand planes are 's' apart
+		template <uint128_t N, typename T, typename W> void batch_det(W w, uint128_t s, const T* __restrict a, T* __restrict r);
+		template <uint128_t N, typename T, typename W> void batch_inverse(W w, uint128_t s, const T* __restrict a, T* __restrict r);
+		template <uint128_t N, typename T, typename W> void batch_solve(W w, uint128_t s, const T* __restrict a, const T* __restrict f, T* __restrict x);
+		template <typename T, typename W> void batch_cross(W w, uint128_t s, const T* __restrict u, const T* __restrict v, T* __restrict r);
+		template <uint128_t M, uint128_t N, uint128_t K, typename T, typename W>
+		void batch_gemm(W w, uint128_t s, const T* __restrict a, const T* __restrict x, T* __restrict r);
+	}
+}
+
+#include "../lib/batched.inl"
@@ -120,17 +120,58 @@ namespace nm
 
 		template <typename _Ty, typename _Vy>
 		struct is_stronger : bool_constant<is_stronger_v<_Ty, _Vy>> {};
+
+		template <typename _Ty>
+		struct real_type { using type = _Ty; };
+
+		template <typename _Ty>
+		struct real_type<base_type::complex_base<_Ty>> { using type = _Ty; };
+
+		template <typename _Ty>
+		using real_type_t = typename real_type<remove_cv_t<_Ty>>::type;
+
+		// result type of elementwise operation between _Ty and _Vy:
+		// integral scalar never promotes, complex wins over floating
+		template <typename _Ty, typename _Vy>
+		struct promote
+		{
+			using _Tr = real_type_t<_Ty>;
+			using _Vr = real_type_t<_Vy>;
+			using _Rr = conditional_t<is_integral<_Vr>::value, _Tr,
+				conditional_t<is_integral<_Tr>::value, _Vr,
+				conditional_t<is_stronger_v<_Tr, _Vr>, _Tr, _Vr>>>;
+			using type = conditional_t<is_complex_v<_Ty> || is_complex_v<_Vy>, base_type::complex_base<_Rr>, _Rr>;
+		};
+
+		template <typename _Ty, typename _Vy>
+		using promote_t = typename promote<_Ty, _Vy>::type;
 	}
 
 	template <typename T> T abs(base_type::complex_base<T> value);
+	template <typename T> base_type::complex_base<T> conj(const base_type::complex_base<T>& value);
+	template <typename T> T real(const base_type::complex_base<T>& value);
+
+	// real numbers are their own conjugate, so generic code can call conj / real on any element
+	template <typename T, typename = typing::enable_if_t<typing::is_floating_point<T>::value>> T conj(const T& value);
+	template <typename T, typename = typing::enable_if_t<typing::is_floating_point<T>::value>> T real(const T& value);
 }
 
 template <typename T>
 std::ostream& operator<<(std::ostream& out, const nm::base_type::complex_base<T>& value);
 
-template <typename T, typename V> auto operator +(const V& value, const nm::base_type::complex_base<T>& c);
-template <typename T, typename V> auto operator -(const V& value, const nm::base_type::complex_base<T>& c);
-template <typename T, typename V> auto operator *(const V& value, const nm::base_type::complex_base<T>& c);
-template <typename T, typename V> auto operator /(const V& value, const nm::base_type::complex_base<T>& c);
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T, typename V, typename = typing::enable_if_t<typing::is_arithmetic<V>::value>>
+		auto operator +(const V& value, const complex_base<T>& c);
+		template <typename T, typename V, typename = typing::enable_if_t<typing::is_arithmetic<V>::value>>
+		auto operator -(const V& value, const complex_base<T>& c);
+		template <typename T, typename V, typename = typing::enable_if_t<typing::is_arithmetic<V>::value>>
+		auto operator *(const V& value, const complex_base<T>& c);
+		template <typename T, typename V, typename = typing::enable_if_t<typing::is_arithmetic<V>::value>>
+		auto operator /(const V& value, const complex_base<T>& c);
+	}
+}
 
 #include "../lib/complex.inl"
@@ -65,3 +65,34 @@
 	*/
 
 #endif 
+
+
+#if 1
+#define SIMD_RUNTIME_DISPATCH
+
+	/*
+	 * SIMD RUNTIME DISPATCH - vector reductions (sum, dot, norms, max, min)
+	 * and in-place operations on float32/float64 use SSE2/AVX2/AVX-512
+	 * kernels, selected at runtime by CPUID. The best instruction set
+	 * supported by the CPU is used, one binary runs on every x86-64 CPU.
+	 *
+	 * Disable this flag to use plain loops only (non-x86 platforms use
+	 * plain loops anyway).
+	 */
+
+#endif
+
+
+#if 1
+#define PARALLEL_PRODUCT
+
+	/*
+	 * PARALLEL PRODUCT - matrix-matrix and matrix-vector products are split
+	 * between threads of the library thread pool. By default all hardware
+	 * threads are used, the count can be changed by 'parallel::set_threads'.
+	 * Products smaller than 'parallel::serial_cutoff' run on one thread.
+	 *
+	 * Disable this flag to run every product on the calling thread only.
+	 */
+
+#endif
@@ -0,0 +1,183 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib decomposition declaration file
+ *
+ * Matrix factorizations, which are computed once and reused:
+ *      lu_base		- PA = LU, partial pivoting
+ *      cholesky_base	- A = L L^H, A is hermitian positive definite
+ *      ldlt_base		- A = L D L^H, A is hermitian, no pivoting
+ *      qr_base			- A = QR, Householder reflections, A is m x n
+ *
+ * LU factorization is blocked: a panel of LU_BLOCK_SIZE columns is
+ * factorized, then the trailing matrix is updated by one matrix product
+ * (see 'gemm.hpp'), so most of the work runs in the gemm kernel.
+ *
+ * L and U are packed into one matrix (unit diagonal of L is not stored),
+ * permutation is kept as a vector of row indices instead of a dense
+ * P matrix. Factorization object solves systems with any number of
+ * right-hand sides, computes det and inverse without refactoring:
+ *
+ *      auto f = nm::lu(A);
+ *      auto x = f.solve(b);		// b - vector or matrix of columns
+ *      auto d = f.det();
+ *
+ * Cholesky and LDL^T are blocked the same way and read only the lower
+ * triangle of A; the trailing update touches only the lower triangle, so
+ * they do half of the LU work. If A is not positive definite (or LDL^T
+ * meets a zero pivot) the factorization stops and 'is_positive' /
+ * 'is_singular' reports it, solve must not be called then. After the
+ * factorization the upper triangle holds L^H, so both substitutions run
+ * in the trsm kernel. In-place variants only overwrite the lower triangle.
+ *
+ * QR is blocked in compact WY form: reflectors of a panel of QR_BLOCK_SIZE
+ * columns are combined into I - V T V^H and applied to the trailing
+ * matrix at once. R is kept in the upper triangle, reflectors below the
+ * diagonal, Q is never formed unless 'q()' is called - 'apply_q' and
+ * 'apply_qh' multiply by Q and Q^H directly. Passes over rows are split
+ * between threads, so tall-skinny matrices (m >> n) run in parallel:
+ *
+ *      auto x = nm::lstsq(A, b);	// min |A x - b|, m >= n, full rank
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct lu_base
+		{
+			lu_base(const matrix_base<T>& matr);
+
+			uint128_t size() const;
+			bool is_singular() const;
+
+			matrix_base<T> lower() const;
+			matrix_base<T> upper() const;
+			matrix_base<T> permutation() const;
+
+			T det() const;
+			matrix_base<T> inverse() const;
+
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			vector_base<T>& solve_inplace(vector_base<T>& b) const;
+			matrix_base<T>& solve_inplace(matrix_base<T>& b) const;
+
+			matrix_base<T> lu;				// L + U - E, packed
+			std::vector<uint128_t> perm;	// row i of PA is row perm[i] of A
+			int32_t sign;					// permutation parity, +1 or -1
+			bool singular;
+		};
+
+		template <typename T>
+		struct cholesky_base
+		{
+			cholesky_base(const matrix_base<T>& matr);
+
+			uint128_t size() const;
+			bool is_positive() const;
+
+			matrix_base<T> lower() const;
+
+			T det() const;
+			matrix_base<T> inverse() const;
+
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			vector_base<T>& solve_inplace(vector_base<T>& b) const;
+			matrix_base<T>& solve_inplace(matrix_base<T>& b) const;
+
+			matrix_base<T> factor;			// L in lower triangle, L^H in upper
+			bool positive;
+		};
+
+		template <typename T>
+		struct ldlt_base
+		{
+			ldlt_base(const matrix_base<T>& matr);
+
+			uint128_t size() const;
+			bool is_singular() const;
+
+			matrix_base<T> lower() const;
+			vector_base<T> diagonal() const;
+
+			T det() const;
+			matrix_base<T> inverse() const;
+
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			vector_base<T>& solve_inplace(vector_base<T>& b) const;
+			matrix_base<T>& solve_inplace(matrix_base<T>& b) const;
+
+			matrix_base<T> factor;			// unit L in lower triangle, D on diagonal, L^H in upper
+			bool singular;
+		};
+
+		template <typename T>
+		struct qr_base
+		{
+			qr_base(const matrix_base<T>& matr);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+
+			matrix_base<T> q() const;		// thin, m x min(m, n)
+			matrix_base<T> r() const;		// min(m, n) x n
+
+			vector_base<T>& apply_q(vector_base<T>& b) const;
+			matrix_base<T>& apply_q(matrix_base<T>& b) const;
+			vector_base<T>& apply_qh(vector_base<T>& b) const;
+			matrix_base<T>& apply_qh(matrix_base<T>& b) const;
+
+			// least squares solution of A x = b, b has m rows, x has n rows
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			matrix_base<T> factor;			// R in upper triangle, reflectors below diagonal (unit head is not stored)
+			vector_base<T> tau;				// H_j = I - tau_j v_j v_j^H
+		};
+	}
+
+	// panel width of the blocked LU, Cholesky and LDL^T
+	constexpr uint128_t LU_BLOCK_SIZE = 64;
+
+	// panel width of the blocked QR
+	constexpr uint128_t QR_BLOCK_SIZE = 32;
+
+	template <typename T> base_type::lu_base<T> lu(const base_type::matrix_base<T>& matr);
+	template <typename T> base_type::cholesky_base<T> cholesky(const base_type::matrix_base<T>& matr);
+	template <typename T> base_type::ldlt_base<T> ldlt(const base_type::matrix_base<T>& matr);
+	template <typename T> base_type::qr_base<T> qr(const base_type::matrix_base<T>& matr);
+
+	template <typename T> base_type::vector_base<T> lstsq(
+		const base_type::matrix_base<T>& matr,
+		const base_type::vector_base<T>& b);
+
+	template <typename T> base_type::matrix_base<T> lstsq(
+		const base_type::matrix_base<T>& matr,
+		const base_type::matrix_base<T>& b);
+
+	// lower triangle of matr is replaced by L, returns false if matr is not positive definite
+	template <typename T> bool cholesky_inplace(base_type::matrix_base<T>& matr);
+
+	// lower triangle of matr is replaced by unit L and diagonal by D, returns false on zero pivot
+	template <typename T> bool ldlt_inplace(base_type::matrix_base<T>& matr);
+
+	// returns C = L + U - E matrix
+	template <typename T> base_type::matrix_base<T> LU_decomposion(const base_type::matrix_base<T>& matr);
+
+	// returns { C = (L + U - E), P } matrices
+	template <typename T> std::tuple<base_type::matrix_base<T>, base_type::matrix_base<T>> LUP_decomposion(const base_type::matrix_base<T>& matr);
+}
+
+#include "../lib/decomposition.inl"
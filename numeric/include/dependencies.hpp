@@ -6,5 +6,14 @@
 #include <format>
 #include <cmath>
 #include <cstdarg>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <limits>
+#include <utility>
 
 #include "config.hpp"
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "decomposition.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib eigen declaration file
+ *
+ * Eigenvalue problem of a hermitian (real symmetric) matrix:
+ *      A = V diag(w) V^H, w is real and sorted ascending, V is unitary
+ *
+ *      auto e = nm::eigh(A);			// e.values, e.vectors (columns)
+ *      auto w = nm::eigvalsh(A);		// values only
+ *
+ * Only the lower triangle of A is read. The matrix is reduced to a real
+ * tridiagonal T = Q^H A Q by Householder reflections: every step makes
+ * one pass over the trailing lower triangle, which applies the previous
+ * rank-2 update and computes the next product A v at once, the pass is
+ * split between threads. T is diagonalized by the implicit QR iteration
+ * with Wilkinson shift.
+ *
+ * Values-only mode never touches an n x n matrix after the reduction,
+ * so it costs 4/3 n^3 + O(n^2). With vectors the plane rotations of every
+ * QR sweep are applied to the rows of Z^T in cache-sized column blocks
+ * (threaded), then V = Q Z is formed by the blocked reflectors of
+ * 'decomposition.hpp'.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct eigen_base
+		{
+			using real_t = typing::real_type_t<T>;
+
+			eigen_base(const matrix_base<T>& matr, bool vectors = true);
+
+			uint128_t size() const;
+			bool is_converged() const;
+
+			vector_base<real_t> values;		// ascending
+			matrix_base<T> vectors;			// column j belongs to values[j], empty in values-only mode
+			bool converged;
+		};
+	}
+
+	template <typename T> base_type::eigen_base<T> eigh(const base_type::matrix_base<T>& matr);
+	template <typename T> base_type::vector_base<typing::real_type_t<T>> eigvalsh(const base_type::matrix_base<T>& matr);
+}
+
+#include "../lib/eigen.inl"
@@ -0,0 +1,284 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+
+/***********************************************************************
+ *
+ *		          NumericLib expression declaration file
+ *
+ * Base classes: vector_expr, matrix_expr, scalar_expr (lazy)
+ *
+ * Elementwise operators (+, - between vectors or matrices, +, -, *, /
+ * with scalars and unary minus) do not compute anything, they return a
+ * light expression object, which remembers operands and operation.
+ * Expression is evaluated element by element when it is assigned to
+ * vector_base/matrix_base (or to a view), so the whole chain like
+ * 'a + b * 2 - c' is computed in one loop without temporaries:
+ *
+ *      vect_t r = a + b * 2 - c;		// one pass, one allocation
+ *      r += a * 3;				// one pass, no allocation
+ *
+ * Operands may be vector_base/matrix_base, views or other expressions.
+ * Result type of each operation follows 'typing::promote' rules, which
+ * are based on 'typing::is_stronger' (see 'complex.hpp').
+ *
+ * Expression keeps references to vector_base/matrix_base operands, so
+ * do not store it with 'auto' if operands are temporaries - convert it
+ * to vector_base/matrix_base or call 'eval()' instead.
+ *
+ * An operand, which is a temporary vector_base/matrix_base (a product,
+ * a function result, std::move), is not referenced: the operation is
+ * evaluated in place into its buffer and the buffer is returned, if the
+ * promoted type is the type of the temporary ('typing::keeps_type_v'):
+ *
+ *      matr_t r = A * B + C;			// C is added into the buffer of A * B
+ *      vect_t y = 2 * (A * x) - b;		// no allocation after A * x
+ *
+ * Otherwise (float32 temporary + float64 operand) it is a lazy
+ * expression as above.
+ *
+ * Assignment of an expression ('=', '+=', '-=') is evaluated in place,
+ * unless one of its operands reads the destination storage at other
+ * positions (a slice or a transposed view of it), then it goes through
+ * a temporary:
+ *
+ *      Q = Q.view().transposed() + Q;		// correct, one temporary
+ *      Q += Q.view().transposed();			// the same
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T> struct vector_base;
+		template <typename T> struct matrix_base;
+		template <typename T> struct vector_view;
+		template <typename T> struct matrix_view;
+		template <typename L, typename R, typename Op> struct vector_expr;
+		template <typename L, typename R, typename Op> struct matrix_expr;
+		template <typename S> struct scalar_expr;
+	}
+
+	namespace typing
+	{
+		template <typename _Ty>
+		struct is_vector_operand : bool_constant<false> {};
+		template <typename T>
+		struct is_vector_operand<base_type::vector_base<T>> : bool_constant<true> {};
+		template <typename T>
+		struct is_vector_operand<base_type::vector_view<T>> : bool_constant<true> {};
+		template <typename L, typename R, typename Op>
+		struct is_vector_operand<base_type::vector_expr<L, R, Op>> : bool_constant<true> {};
+
+		template <typename _Ty>
+		constexpr bool is_vector_operand_v = is_vector_operand<remove_cv_t<_Ty>>::value;
+
+		template <typename _Ty>
+		struct is_matrix_operand : bool_constant<false> {};
+		template <typename T>
+		struct is_matrix_operand<base_type::matrix_base<T>> : bool_constant<true> {};
+		template <typename T>
+		struct is_matrix_operand<base_type::matrix_view<T>> : bool_constant<true> {};
+		template <typename L, typename R, typename Op>
+		struct is_matrix_operand<base_type::matrix_expr<L, R, Op>> : bool_constant<true> {};
+
+		template <typename _Ty>
+		constexpr bool is_matrix_operand_v = is_matrix_operand<remove_cv_t<_Ty>>::value;
+
+		template <typename _Ty>
+		struct is_owning : bool_constant<false> {};
+		template <typename T>
+		struct is_owning<base_type::vector_base<T>> : bool_constant<true> {};
+		template <typename T>
+		struct is_owning<base_type::matrix_base<T>> : bool_constant<true> {};
+
+		template <typename _Ty>
+		constexpr bool is_owning_v = is_owning<remove_cv_t<_Ty>>::value;
+
+		template <typename _Ty>
+		constexpr bool is_scalar_v = is_arithmetic<_Ty>::value || is_complex<_Ty>::value;
+
+		// operation between _Ty and _Vy results in _Ty, so a temporary of _Ty can hold it
+		template <typename _Ty, typename _Vy>
+		constexpr bool keeps_type_v = is_same_v<promote_t<_Ty, _Vy>, _Ty>;
+
+		// operand is stored by reference if it owns memory, by value otherwise
+		template <typename _Ty>
+		using operand_t = conditional_t<is_owning_v<_Ty>, const _Ty&, _Ty>;
+
+		template <bool _Test>
+		using require = enable_if_t<_Test, int>;
+	}
+
+	namespace base_type
+	{
+		namespace expr_op
+		{
+			struct add { template <typename A, typename B> static auto apply(const A& a, const B& b) { return a + b; } };
+			struct sub { template <typename A, typename B> static auto apply(const A& a, const B& b) { return a - b; } };
+			struct mul { template <typename A, typename B> static auto apply(const A& a, const B& b) { return a * b; } };
+			struct div { template <typename A, typename B> static auto apply(const A& a, const B& b) { return a / b; } };
+			struct neg { template <typename A, typename B> static auto apply(const A& a, const B&) { return -a; } };
+		}
+
+		template <typename S>
+		struct scalar_expr
+		{
+			using value_type = S;
+
+			scalar_expr(const S& value);
+
+			S value;
+		};
+
+		template <typename L, typename R, typename Op>
+		struct vector_expr
+		{
+			using value_type = typing::promote_t<typename L::value_type, typename R::value_type>;
+
+			vector_expr(const L& lhs, const R& rhs);
+
+			uint128_t size() const;
+			value_type operator [](uint128_t i) const;
+
+			vector_base<value_type> eval() const;
+
+			typing::operand_t<L> lhs;
+			typing::operand_t<R> rhs;
+		};
+
+		template <typename L, typename R, typename Op>
+		struct matrix_expr
+		{
+			using value_type = typing::promote_t<typename L::value_type, typename R::value_type>;
+
+			matrix_expr(const L& lhs, const R& rhs);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+			value_type operator ()(uint128_t i, uint128_t j) const;
+
+			matrix_base<value_type> eval() const;
+
+			typing::operand_t<L> lhs;
+			typing::operand_t<R> rhs;
+		};
+
+		// storage referenced by an operand, assignments compare it with the
+		// destination: aliased operands are evaluated into a temporary first
+		struct footprint
+		{
+			const char* lo;			// [lo, hi) bytes
+			const char* hi;
+			const void* ptr;		// first element, steps are in elements
+			int128_t rstep;
+			int128_t cstep;
+			uint128_t elem;			// element size
+		};
+
+		template <typename T> footprint storage(const vector_base<T>& vect);
+		template <typename T> footprint storage(const vector_view<T>& view);
+		template <typename T> footprint storage(const matrix_base<T>& matr);
+		template <typename T> footprint storage(const matrix_view<T>& view);
+
+		// true if the operand reads elements of 'dst' other than the one being
+		// written: storage overlaps and is not the same elements in the same order
+		template <typename E> bool aliases(const footprint& dst, const E& operand);
+		template <typename S> bool aliases(const footprint& dst, const scalar_expr<S>& scalar);
+		template <typename L, typename R, typename Op> bool aliases(const footprint& dst, const vector_expr<L, R, Op>& expr);
+		template <typename L, typename R, typename Op> bool aliases(const footprint& dst, const matrix_expr<L, R, Op>& expr);
+
+		// order of an element-wise update of vector 'dst' from an aliased operand:
+		// 1 - forward, -1 - backward (same step, destination ahead of the operand),
+		// 0 - no safe order, the operand has to be evaluated into a temporary
+		template <typename E> int32_t update_order(const footprint& dst, const E& operand);
+		template <typename L, typename R, typename Op> int32_t update_order(const footprint& dst, const vector_expr<L, R, Op>& expr);
+
+		template <typename V> const V& owning(const V& value);
+		template <typename V> vector_base<typing::remove_cv_t<V>> owning(const vector_view<V>& view);
+		template <typename V> matrix_base<typing::remove_cv_t<V>> owning(const matrix_view<V>& view);
+		template <typename L, typename R, typename Op> auto owning(const vector_expr<L, R, Op>& expr);
+		template <typename L, typename R, typename Op> auto owning(const matrix_expr<L, R, Op>& expr);
+
+		template <typename E, typing::require<typing::is_vector_operand_v<E>> = 0> auto operator -(const E& vect);
+		template <typename E, typing::require<typing::is_matrix_operand_v<E>> = 0> auto operator -(const E& matr);
+
+		template <typename L, typename R, typing::require<typing::is_vector_operand_v<L> && typing::is_vector_operand_v<R>> = 0> auto operator +(const L& lhs, const R& rhs);
+		template <typename L, typename R, typing::require<typing::is_vector_operand_v<L> && typing::is_vector_operand_v<R>> = 0> auto operator -(const L& lhs, const R& rhs);
+
+		template <typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator +(const L& vect, const S& value);
+		template <typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator -(const L& vect, const S& value);
+		template <typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator *(const L& vect, const S& value);
+		template <typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator /(const L& vect, const S& value);
+
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>> = 0> auto operator +(const S& value, const R& vect);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>> = 0> auto operator -(const S& value, const R& vect);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>> = 0> auto operator *(const S& value, const R& vect);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>> = 0> auto operator /(const S& value, const R& vect);
+
+		template <typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && typing::is_matrix_operand_v<R>> = 0> auto operator +(const L& lhs, const R& rhs);
+		template <typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && typing::is_matrix_operand_v<R>> = 0> auto operator -(const L& lhs, const R& rhs);
+
+		template <typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator +(const L& matr, const S& value);
+		template <typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator -(const L& matr, const S& value);
+		template <typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator *(const L& matr, const S& value);
+		template <typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>> = 0> auto operator /(const L& matr, const S& value);
+
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>> = 0> auto operator +(const S& value, const R& matr);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>> = 0> auto operator -(const S& value, const R& matr);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>> = 0> auto operator *(const S& value, const R& matr);
+		template <typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>> = 0> auto operator /(const S& value, const R& matr);
+
+		// temporary operands: evaluated in place, see 'keeps_type_v'
+		template <typename T> vector_base<T> operator -(vector_base<T>&& vect);
+		template <typename T> matrix_base<T> operator -(matrix_base<T>&& matr);
+
+		template <typename T, typename R, typing::require<typing::is_vector_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>> = 0> vector_base<T> operator +(vector_base<T>&& lhs, const R& rhs);
+		template <typename T, typename R, typing::require<typing::is_vector_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>> = 0> vector_base<T> operator -(vector_base<T>&& lhs, const R& rhs);
+		template <typename L, typename T, typing::require<typing::is_vector_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>> = 0> vector_base<T> operator +(const L& lhs, vector_base<T>&& rhs);
+		template <typename L, typename T, typing::require<typing::is_vector_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>> = 0> vector_base<T> operator -(const L& lhs, vector_base<T>&& rhs);
+		template <typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>> = 0> auto operator +(vector_base<T>&& lhs, vector_base<V>&& rhs);
+		template <typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>> = 0> auto operator -(vector_base<T>&& lhs, vector_base<V>&& rhs);
+
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator +(vector_base<T>&& vect, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator -(vector_base<T>&& vect, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator *(vector_base<T>&& vect, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator /(vector_base<T>&& vect, const S& value);
+
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator +(const S& value, vector_base<T>&& vect);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator -(const S& value, vector_base<T>&& vect);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator *(const S& value, vector_base<T>&& vect);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> vector_base<T> operator /(const S& value, vector_base<T>&& vect);
+
+		template <typename T, typename R, typing::require<typing::is_matrix_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>> = 0> matrix_base<T> operator +(matrix_base<T>&& lhs, const R& rhs);
+		template <typename T, typename R, typing::require<typing::is_matrix_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>> = 0> matrix_base<T> operator -(matrix_base<T>&& lhs, const R& rhs);
+		template <typename L, typename T, typing::require<typing::is_matrix_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>> = 0> matrix_base<T> operator +(const L& lhs, matrix_base<T>&& rhs);
+		template <typename L, typename T, typing::require<typing::is_matrix_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>> = 0> matrix_base<T> operator -(const L& lhs, matrix_base<T>&& rhs);
+		template <typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>> = 0> auto operator +(matrix_base<T>&& lhs, matrix_base<V>&& rhs);
+		template <typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>> = 0> auto operator -(matrix_base<T>&& lhs, matrix_base<V>&& rhs);
+
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator +(matrix_base<T>&& matr, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator -(matrix_base<T>&& matr, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator *(matrix_base<T>&& matr, const S& value);
+		template <typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator /(matrix_base<T>&& matr, const S& value);
+
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator +(const S& value, matrix_base<T>&& matr);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator -(const S& value, matrix_base<T>&& matr);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator *(const S& value, matrix_base<T>&& matr);
+		template <typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>> = 0> matrix_base<T> operator /(const S& value, matrix_base<T>&& matr);
+
+		// matrix products are not elementwise, views and expressions are evaluated first
+		template <typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && (typing::is_matrix_operand_v<R> || typing::is_vector_operand_v<R>)
+			&& !(typing::is_owning_v<L> && typing::is_owning_v<R>)> = 0> auto operator *(const L& lhs, const R& rhs);
+	}
+}
+
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::vector_base<T>& vector);
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::matrix_base<T>& matrix);
+
+template <typename L, typename R, typename Op> std::ostream& operator <<(std::ostream& out, const nm::base_type::vector_expr<L, R, Op>& expr);
+template <typename L, typename R, typename Op> std::ostream& operator <<(std::ostream& out, const nm::base_type::matrix_expr<L, R, Op>& expr);
+
+#include "../lib/expression.inl"
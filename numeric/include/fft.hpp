@@ -0,0 +1,111 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib fft declaration file
+ *
+ * Discrete Fourier transform of complex and real signals:
+ *      X_k = sum x_j exp(-2 pi i j k / n), inverse is scaled by 1 / n
+ *
+ *      auto X = nm::fft(x);		// x - vect64c_t, vect128c_t, ...
+ *      auto y = nm::ifft(X);
+ *      auto H = nm::rfft(r);		// r - real, n / 2 + 1 values
+ *      auto r = nm::irfft(H, n);
+ *
+ * Transforms of one size should go through a plan: factorization and
+ * twiddle tables are computed once, the plan owns its workspace, so the
+ * repeated calls never allocate:
+ *
+ *      nm::base_type::fft_plan<float64_t> plan(65536);
+ *      plan.forward(x);			// in place
+ *      plan.forward(signals);		// every row of a matrix, rows are split between threads
+ *
+ * Plan runs the Stockham autosort algorithm: every pass reads one buffer
+ * and writes another with unit stride in the inner loop, there is no
+ * bit reversal. Sizes are factorized into radices 4, 2, 3 and other
+ * primes up to FFT_MAX_RADIX (plain DFT butterflies), sizes with a larger
+ * prime factor use Bluestein's algorithm: a chirp convolution by a
+ * power-of-two transform, which keeps n log n cost for any n.
+ *
+ * Real transform of even size packs the signal into a complex one of
+ * size n / 2 and splits the spectrum afterwards, so it costs half of the
+ * complex transform. The methods which take a raw workspace pointer are
+ * const, so one plan can be shared between threads.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	// largest radix done by a plain DFT butterfly, larger prime factors switch the plan to Bluestein
+	constexpr uint128_t FFT_MAX_RADIX = 31;
+
+	namespace base_type
+	{
+		template <typename T>
+		struct fft_plan
+		{
+			using value_type = complex_base<T>;
+
+			fft_plan(uint128_t n = 0);
+
+			uint128_t size() const;
+			uint128_t workspace() const;				// size of the work buffer of 'transform'
+			bool is_bluestein() const;
+
+			void forward(vector_base<value_type>& x);
+			void inverse(vector_base<value_type>& x);
+			void forward(matrix_base<value_type>& signals);		// every row, size() columns
+			void inverse(matrix_base<value_type>& signals);
+
+			// in-place transform of x[0 .. n), work holds workspace() values
+			void transform(value_type* x, value_type* work, bool inverse) const;
+
+			uint128_t n;
+			std::vector<uint128_t> radices;			// Stockham passes, first to last
+			std::vector<value_type> twiddles;		// w^(u k) of every pass
+			std::vector<value_type> work;
+
+			// Bluestein: transform of the padded size, chirp exp(-i pi k^2 / n) and spectrum of its conjugate / m
+			std::vector<fft_plan> inner;
+			std::vector<value_type> chirp;
+			std::vector<value_type> spectrum;
+
+			void execute(value_type* x, value_type* work) const;		// forward, no Bluestein
+		};
+
+		template <typename T>
+		struct rfft_plan
+		{
+			using value_type = complex_base<T>;
+
+			rfft_plan(uint128_t n = 0);
+
+			uint128_t size() const;
+
+			// spectrum gets n / 2 + 1 values, signal gets n values
+			void forward(const vector_base<T>& signal, vector_base<value_type>& spectrum);
+			void inverse(const vector_base<value_type>& spectrum, vector_base<T>& signal);
+
+			vector_base<value_type> forward(const vector_base<T>& signal);
+			vector_base<T> inverse(const vector_base<value_type>& spectrum);
+
+			uint128_t n;
+			fft_plan<T> plan;					// n / 2 for even n, n otherwise
+			std::vector<value_type> twiddles;	// exp(-2 pi i k / n), k < n / 2
+			std::vector<value_type> buffer;
+		};
+	}
+
+	template <typename T> base_type::vector_base<base_type::complex_base<T>> fft(const base_type::vector_base<base_type::complex_base<T>>& x);
+	template <typename T> base_type::vector_base<base_type::complex_base<T>> ifft(const base_type::vector_base<base_type::complex_base<T>>& x);
+
+	template <typename T> base_type::vector_base<base_type::complex_base<T>> rfft(const base_type::vector_base<T>& x);
+	template <typename T> base_type::vector_base<T> irfft(const base_type::vector_base<base_type::complex_base<T>>& x, uint128_t n);
+}
+
+#include "../lib/fft.inl"
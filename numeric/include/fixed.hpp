@@ -0,0 +1,159 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib fixed declaration file
+ *
+ * Base class: fixed_vector<T, N>, fixed_matrix<T, M, N> (plain array, row-major)
+ * Inner type: T (any)
+ *
+ * Declared types:
+ *      vect2_32f_t, vect3_32f_t, vect4_32f_t	= { float32_t } x 2, 3, 4
+ *      vect2_64f_t, vect3_64f_t, vect4_64f_t	= { float64_t } x 2, 3, 4
+ *      matr2_32f_t, matr3_32f_t, matr4_32f_t	= { float32_t } 2 x 2, 3 x 3, 4 x 4
+ *      matr2_64f_t, matr3_64f_t, matr4_64f_t	= { float64_t } 2 x 2, 3 x 3, 4 x 4
+ *
+ * Sizes are template parameters, so the elements live inside the object
+ * (on the stack), nothing is ever allocated and every loop has constant
+ * bounds, which the compiler unrolls. All the operations are constexpr:
+ *
+ *      constexpr nm::matr3_64f_t R = {{ 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 }};
+ *      constexpr auto d = R.det();
+ *      static_assert(R * R.inversed() == nm::matr3_64f_t::identity());
+ *
+ * det and inversed are written out by cofactors for 2 x 2, 3 x 3 and
+ * 4 x 4, larger sizes run Gauss elimination with partial pivoting in
+ * place. Fixed and dynamic types convert both ways: the constructor
+ * from vector_base / matrix_base asserts the size, the conversion
+ * operator returns a new dynamic object.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T, uint128_t N>
+		struct fixed_vector
+		{
+			static_assert(N > 0, "fixed_vector must not be empty!");
+
+			constexpr fixed_vector();
+			constexpr fixed_vector(T value);
+			constexpr fixed_vector(const std::initializer_list<T>& rawvect);
+			explicit fixed_vector(const vector_base<T>& vect);
+
+			operator vector_base<T>() const;
+
+			static constexpr uint128_t size();
+
+			constexpr T& operator [](uint128_t i);
+			constexpr const T& operator [](uint128_t i) const;
+
+			constexpr T* data();
+			constexpr const T* data() const;
+
+			constexpr T dot(const fixed_vector& oth) const;
+			constexpr fixed_vector cross(const fixed_vector& oth) const;		// N = 3 only
+			constexpr T sumsq() const;
+			T norm2() const;
+			fixed_vector normalized() const;
+
+			constexpr fixed_vector operator -() const;
+
+			constexpr fixed_vector& operator +=(const fixed_vector& oth);
+			constexpr fixed_vector& operator -=(const fixed_vector& oth);
+			constexpr fixed_vector& operator *=(const T& value);
+			constexpr fixed_vector& operator /=(const T& value);
+
+			constexpr fixed_vector operator +(const fixed_vector& oth) const;
+			constexpr fixed_vector operator -(const fixed_vector& oth) const;
+			constexpr fixed_vector operator *(const T& value) const;
+			constexpr fixed_vector operator /(const T& value) const;
+
+			constexpr bool operator ==(const fixed_vector& oth) const;
+			constexpr bool operator !=(const fixed_vector& oth) const;
+
+			using value_type = T;
+
+			T base[N];
+		};
+
+		template <typename T, uint128_t M, uint128_t N>
+		struct fixed_matrix
+		{
+			static_assert(M > 0 && N > 0, "fixed_matrix must not be empty!");
+
+			constexpr fixed_matrix();
+			constexpr fixed_matrix(T value);
+			constexpr fixed_matrix(const std::initializer_list<std::initializer_list<T>>& rawmatr);
+			explicit fixed_matrix(const matrix_base<T>& matr);
+
+			operator matrix_base<T>() const;
+
+			static constexpr fixed_matrix identity();
+
+			static constexpr uint128_t rows();
+			static constexpr uint128_t cols();
+
+			constexpr T& operator ()(uint128_t i, uint128_t j);
+			constexpr const T& operator ()(uint128_t i, uint128_t j) const;
+
+			constexpr T* data();
+			constexpr const T* data() const;
+
+			constexpr fixed_vector<T, N> row(uint128_t i) const;
+			constexpr fixed_vector<T, M> col(uint128_t j) const;
+
+			constexpr fixed_matrix<T, N, M> transposed() const;
+			constexpr T trace() const;
+			constexpr T det() const;
+			constexpr fixed_matrix inversed() const;
+
+			constexpr fixed_matrix operator -() const;
+
+			constexpr fixed_matrix& operator +=(const fixed_matrix& oth);
+			constexpr fixed_matrix& operator -=(const fixed_matrix& oth);
+			constexpr fixed_matrix& operator *=(const T& value);
+			constexpr fixed_matrix& operator /=(const T& value);
+
+			constexpr fixed_matrix operator +(const fixed_matrix& oth) const;
+			constexpr fixed_matrix operator -(const fixed_matrix& oth) const;
+			constexpr fixed_matrix operator *(const T& value) const;
+			constexpr fixed_matrix operator /(const T& value) const;
+
+			template <uint128_t K> constexpr fixed_matrix<T, M, K> operator *(const fixed_matrix<T, N, K>& oth) const;
+			constexpr fixed_vector<T, M> operator *(const fixed_vector<T, N>& vect) const;
+
+			constexpr bool operator ==(const fixed_matrix& oth) const;
+			constexpr bool operator !=(const fixed_matrix& oth) const;
+
+			using value_type = T;
+
+			T base[M * N];
+		};
+
+		template <typename T, uint128_t N> constexpr fixed_vector<T, N> operator *(const T& value, const fixed_vector<T, N>& vect);
+		template <typename T, uint128_t M, uint128_t N> constexpr fixed_matrix<T, M, N> operator *(const T& value, const fixed_matrix<T, M, N>& matr);
+	}
+
+	typedef base_type::fixed_vector<float32_t, 2>	vect2_32f_t;
+	typedef base_type::fixed_vector<float32_t, 3>	vect3_32f_t;
+	typedef base_type::fixed_vector<float32_t, 4>	vect4_32f_t;
+	typedef base_type::fixed_vector<float64_t, 2>	vect2_64f_t;
+	typedef base_type::fixed_vector<float64_t, 3>	vect3_64f_t;
+	typedef base_type::fixed_vector<float64_t, 4>	vect4_64f_t;
+
+	typedef base_type::fixed_matrix<float32_t, 2, 2>	matr2_32f_t;
+	typedef base_type::fixed_matrix<float32_t, 3, 3>	matr3_32f_t;
+	typedef base_type::fixed_matrix<float32_t, 4, 4>	matr4_32f_t;
+	typedef base_type::fixed_matrix<float64_t, 2, 2>	matr2_64f_t;
+	typedef base_type::fixed_matrix<float64_t, 3, 3>	matr3_64f_t;
+	typedef base_type::fixed_matrix<float64_t, 4, 4>	matr4_64f_t;
+}
+
+#include "../lib/fixed.inl"
@@ -0,0 +1,117 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib gemm declaration file
+ *
+ * General matrix multiplication kernel:
+ *      C = alpha * A * B + beta * C
+ *
+ * A is m x k, B is k x n and C is m x n, all stored row-major with
+ * leading dimensions lda, ldb, ldc. The kernel is used by
+ * matrix_base::operator* and matrix_base::dot.
+ *
+ * Matrices are split into blocks, which fit the cache levels:
+ *      NC columns of B   - L3 cache
+ *      KC x NC panel of B - packed, L2/L3 cache
+ *      MC x KC panel of A - packed, L2 cache
+ *      MR x NR tile of C  - micro-kernel, kept in registers
+ *
+ * Block sizes are selected by 'gemm_block<T>' for float32, float64 and
+ * complex types. Small products skip packing and use a plain i-k-j loop.
+ *
+ * Large products are split between threads of the library pool (see
+ * 'parallel.hpp'): every thread computes its own row blocks of C, packed
+ * panel of B is shared.
+ *
+ * Triangular solves (trsv, trsm) are built on the same kernels and are
+ * used by factorizations (see 'decomposition.hpp') and 'nm::solve'.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace kernel
+	{
+		template <typename T>
+		struct gemm_block
+		{
+			static constexpr uint128_t MR = 4;
+			static constexpr uint128_t NR = 4;
+			static constexpr uint128_t KC = 256;
+			static constexpr uint128_t MC = 64;
+			static constexpr uint128_t NC = 2048;
+		};
+
+		template <>
+		struct gemm_block<float32_t>
+		{
+			static constexpr uint128_t MR = 4;
+			static constexpr uint128_t NR = 16;
+			static constexpr uint128_t KC = 256;
+			static constexpr uint128_t MC = 128;
+			static constexpr uint128_t NC = 4096;
+		};
+
+		template <>
+		struct gemm_block<float64_t>
+		{
+			static constexpr uint128_t MR = 4;
+			static constexpr uint128_t NR = 8;
+			static constexpr uint128_t KC = 256;
+			static constexpr uint128_t MC = 96;
+			static constexpr uint128_t NC = 4096;
+		};
+
+		template <>
+		struct gemm_block<complex64_t>
+		{
+			static constexpr uint128_t MR = 2;
+			static constexpr uint128_t NR = 8;
+			static constexpr uint128_t KC = 256;
+			static constexpr uint128_t MC = 64;
+			static constexpr uint128_t NC = 2048;
+		};
+
+		template <>
+		struct gemm_block<complex128_t>
+		{
+			static constexpr uint128_t MR = 2;
+			static constexpr uint128_t NR = 4;
+			static constexpr uint128_t KC = 128;
+			static constexpr uint128_t MC = 64;
+			static constexpr uint128_t NC = 2048;
+		};
+
+		// products with m * n * k below this value use the plain loop
+		constexpr uint128_t GEMM_SMALL_SIZE = 48 * 48 * 48;
+
+		// size of diagonal blocks in trsm
+		constexpr uint128_t TRSM_BLOCK_SIZE = 64;
+
+		// level 1 helpers for contiguous rows: y += alpha * x, and x . y
+		template <typename T> void row_axpy(uint128_t n, const T& alpha, const T* x, T* y);
+		template <typename T> T row_dot(uint128_t n, const T* x, const T* y);
+
+		template <typename T>
+		void gemm(uint128_t m, uint128_t n, uint128_t k,
+			const T& alpha, const T* a, uint128_t lda, const T* b, uint128_t ldb,
+			const T& beta, T* c, uint128_t ldc);
+
+		// triangular solve in place: A x = b, A is n x n lower or upper triangle,
+		// 'unit' - diagonal of A is 1 and not referenced
+		template <typename T>
+		void trsv(bool lower, bool unit, uint128_t n, const T* a, uint128_t lda, T* x);
+
+		// triangular solve in place: A X = B, B is n x k, right-hand sides are
+		// columns of B; the diagonal blocks are solved directly, the rest by gemm
+		template <typename T>
+		void trsm(bool lower, bool unit, uint128_t n, uint128_t k, const T* a, uint128_t lda, T* b, uint128_t ldb);
+	}
+}
+
+#include "../lib/gemm.inl"
@@ -0,0 +1,116 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "sparse.hpp"
+#include "banded.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib iterative declaration file
+ *
+ * Krylov solvers, which need only products A * x:
+ *      cg			- conjugate gradient, A is hermitian positive definite
+ *      bicgstab	- stabilized biconjugate gradient, general A
+ *      gmres		- restarted GMRES(m), general A, residual never grows
+ *
+ * Matrix is passed as linear_operator, which is built from matrix_base,
+ * sparse_matrix, band_matrix or from a function y = A x:
+ *
+ *      nm::base_type::linear_operator<float64_t> A(n, [&](const vect64f_t& x, vect64f_t& y) { ... });
+ *
+ * Operator keeps a reference to the matrix, the matrix must outlive it.
+ *
+ * Solver object owns all work vectors (and the Hessenberg matrix of
+ * GMRES), they are allocated at the first solve and reused by the next
+ * solves of the same size, so the iterations never allocate:
+ *
+ *      nm::base_type::krylov_base<float64_t> solver(1e-10);
+ *      solver.cg(A, b, x);					// x - initial guess and result
+ *      solver.iterations(), solver.history()	// |r_k| / |b| for every k
+ *
+ * Iterations stop when |b - A x| <= tolerance * |b| or after
+ * 'max_iterations' products (GMRES counts inner iterations). One-shot
+ * functions 'nm::cg', 'nm::bicgstab' and 'nm::gmres' start from zero.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct linear_operator
+		{
+			using function_t = std::function<void(const vector_base<T>&, vector_base<T>&)>;
+
+			linear_operator(uint128_t n, function_t matvec);
+			linear_operator(const matrix_base<T>& matr);
+			linear_operator(const sparse_matrix<T>& matr);
+			linear_operator(const band_matrix<T>& matr);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+
+			void apply(const vector_base<T>& x, vector_base<T>& y) const;		// y = A x, y has the right size
+
+			using value_type = T;
+
+			uint128_t n;
+			function_t matvec;
+		};
+
+		template <typename T>
+		struct krylov_base
+		{
+			using real_t = typing::real_type_t<T>;
+
+			krylov_base(
+				real_t tolerance = std::sqrt(std::numeric_limits<real_t>::epsilon()),
+				uint128_t max_iterations = 1000,
+				uint128_t restart = 30);
+
+			bool cg(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x);
+			bool bicgstab(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x);
+			bool gmres(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x);
+
+			bool converged() const;
+			uint128_t iterations() const;
+			real_t residual() const;						// last |r| / |b|
+			const std::vector<real_t>& history() const;		// |r| / |b| before the first and after every iteration
+
+			real_t tolerance;
+			uint128_t max_iterations;
+			uint128_t restart;
+
+			bool success;
+			uint128_t count;
+			std::vector<real_t> residuals;
+
+			std::vector<vector_base<T>> work;			// r, p, q, ... or Krylov basis of GMRES
+			matrix_base<T> hessenberg;					// (restart + 1) x restart, GMRES only
+			std::vector<T> rotation_c, rotation_s, g;
+
+			void prepare(uint128_t n, uint128_t vectors, vector_base<T>& x);	// reallocates the workspace only when the sizes change
+			bool record(real_t value);											// true if converged
+		};
+	}
+
+	template <typename M, typename T> base_type::vector_base<T> cg(
+		const M& matr,
+		const base_type::vector_base<T>& b,
+		typing::real_type_t<T> tolerance = std::sqrt(std::numeric_limits<typing::real_type_t<T>>::epsilon()));
+
+	template <typename M, typename T> base_type::vector_base<T> bicgstab(
+		const M& matr,
+		const base_type::vector_base<T>& b,
+		typing::real_type_t<T> tolerance = std::sqrt(std::numeric_limits<typing::real_type_t<T>>::epsilon()));
+
+	template <typename M, typename T> base_type::vector_base<T> gmres(
+		const M& matr,
+		const base_type::vector_base<T>& b,
+		typing::real_type_t<T> tolerance = std::sqrt(std::numeric_limits<typing::real_type_t<T>>::epsilon()),
+		uint128_t restart = 30);
+}
+
+#include "../lib/iterative.inl"
@@ -1,36 +1,69 @@
 #pragma once
 #include "types.hpp"
 #include "vector.hpp"
+#include "view.hpp"
+#include "gemm.hpp"
+#include "transpose.hpp"
+#include "parallel.hpp"
 
 /***********************************************************************
  *
- *		            NumericLib vector declaration file
+ *		            NumericLib matrix declaration file
  *
- * Base class: vector_base (std::vector)
+ * Base class: matrix_base (memory::vector, row-major, see 'memory.hpp')
  * Inner type: T (any)
  *
  * Declared types:
- *      vect32_t =  { float32_t }
- *      vect64_t =  { float64_t }
- *      vect128_t = { float128_t }
+ *      matr32f_t =  { float32_t }
+ *      matr64f_t =  { float64_t }
+ *      matr128f_t = { float128_t }
+ *
+ *      matr64c_t =  { complex64_t }
+ *      matr128c_t = { complex128_t }
+ *      matr256c_t = { complex256_t }
  *
  * Base type:
- *      vect_t =  { float_t }
- *      vectc_t = { complex_t }
+ *      matrf_t = { float_t }
+ *      matrc_t = { complex_t }
+ *
+ * Matrix elements are stored in one contiguous row-major buffer, element
+ * (i, j) is located at 'base[i * ld + j]', where 'ld' is the leading
+ * dimension (distance between two rows). Matrix is allocated once, so
+ * row(i) and operator[] return vector_view into the buffer and
+ * 'matr[i][j]' syntax still works without any copies.
+ *
+ * By default rows are packed (ld = cols). Padded layout rounds ld up to
+ * 'memory::padded_ld': every row starts on a cache line and rows of
+ * 1024 or 2048 float64 are no longer a multiple of 4 Kb apart, so column
+ * walks (transposition, factorizations, 'col') stop evicting each other
+ * from the same cache sets. Padding is never read or written. Kernels
+ * may check 'is_aligned' (every row is aligned) to use aligned stores.
  *
- * Vector variable can be represented by any other type, but full operator
- * overrides functionality works only for DECLARED_TYPES to avoid errors.
- * Anyway, you always can create new operator override by hand, but there are
- * no guarantess that library would be working properly with user types.
+ *      nm::matr64f_t A(2048, 2048, nm::layout_t::padded);
+ *      nm::matr64f_t B(C, nm::layout_t::padded);	// padded copy of C
+ *
+ * row, col, diagonal and slice return views (see 'view.hpp'), which
+ * reference the matrix storage instead of copying it. Elementwise
+ * arithmetic is lazy and evaluated in one pass (see 'expression.hpp').
+ * Matrix-matrix and matrix-vector products use the library thread pool
+ * for large sizes (see 'parallel.hpp'). 'transposed' is blocked and
+ * 'transpose' works in place without a second matrix (see 'transpose.hpp').
  *
  * Basic operations, such as 'abs', 'norm', 'dot', etc declared at 'operations.hpp'.
- * There also defined literal override, which makes it possible to use 'N'
- * literal to define a vector size N, filled by 1. Example: vect_t v = 10N.
+ * Factorizations (LU, ...) declared at 'decomposition.hpp'.
+ * Band matrices ('multidiagonal') declared at 'banded.hpp'.
+ * Diagonal, identity and zero matrices declared at 'structured.hpp'.
  *
 /***********************************************************************/
 
 namespace nm
 {
+	enum class layout_t
+	{
+		packed,			// ld = cols
+		padded			// ld = memory::padded_ld<T>(cols)
+	};
+
 	namespace base_type
 	{
 		template <typename T>
@@ -44,9 +77,17 @@ namespace nm
 			matrix_base(uint128_t mn = 0);
 			matrix_base(uint128_t m, uint128_t n);
 			matrix_base(uint128_t m, uint128_t n, T value);
+			matrix_base(uint128_t m, uint128_t n, layout_t layout);
+			matrix_base(const matrix_base& oth, layout_t layout);
 			matrix_base(const std::vector<std::vector<T>>& stdmatr);
 			matrix_base(const std::initializer_list<std::initializer_list<T>>& rawmatr);
 
+			template <typename L, typename R, typename Op>
+			matrix_base(const matrix_expr<L, R, Op>& expr);
+
+			template <typename L, typename R, typename Op>
+			matrix_base& operator =(const matrix_expr<L, R, Op>& expr);
+
 			matrix_base& fill(T value);
 			matrix_base& fill_diagonal(T value, int32_t index = 0);
 			matrix_base& fill_diagonal(vector_base<T> values, int32_t index = 0);
@@ -55,17 +96,35 @@ namespace nm
 			uint128_t cols() const;
 			std::pair<uint128_t, uint128_t> size() const;
 
-			vector_base<T>& row(int i);
-			const vector_base<T>& row(int i) const;
+			T* data();
+			const T* data() const;
+			uint128_t leading_dim() const;
+			layout_t layout() const;
+			bool is_padded() const;
+			bool is_aligned() const;
+
+			T& operator ()(uint128_t i, uint128_t j);
+			const T& operator ()(uint128_t i, uint128_t j) const;
+
+			vector_view<T> row(int i);
+			vector_view<const T> row(int i) const;
+
+			vector_view<T> col(int i);
+			vector_view<const T> col(int i) const;
+
+			vector_view<T> diagonal(int i = 0);
+			vector_view<const T> diagonal(int i = 0) const;
 
-			vector_base<T> col(int i) const;
-			vector_base<T> diagonal(int i) const;
+			vector_view<T> operator [](int i);
+			vector_view<const T> operator [](int i) const;
 
-			vector_base<T>& operator [](int i);
-			const vector_base<T>& operator [](int i) const;
+			matrix_view<T> view();
+			matrix_view<const T> view() const;
 
-			matrix_base slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, 
+			matrix_view<T> slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, 
 				uint32_t rstep = 1, uint32_t cstep = 1);
+			matrix_view<const T> slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, 
+				uint32_t rstep = 1, uint32_t cstep = 1) const;
 
 			uint128_t row_max() const;
 			uint128_t row_min() const;
@@ -74,6 +133,8 @@ namespace nm
 
 			bool is_square() const;
 			bool is_diagonal() const;
+			bool is_symmetric() const;
+			bool is_hermitian() const;
 
 			bool is_triangle() const;
 			bool is_triangleU() const;
@@ -82,6 +143,7 @@ namespace nm
 			matrix_base& transpose();
 			matrix_base transposed() const;
 
+			matrix_base& inverse();
 			matrix_base inversed() const;
 			matrix_base adjugate() const;
 			matrix_base conjugate() const;
@@ -93,34 +155,24 @@ namespace nm
 			template <typename V> auto dot(const matrix_base<V>& oth) const;
 			template <typename V> auto dot(const vector_base<V>& vec) const;
 
-			matrix_base operator -() const;
-
-			template <typename V> auto operator +(const matrix_base<V>& oth) const;
-			template <typename V> auto operator -(const matrix_base<V>& oth) const;
 			template <typename V> auto operator *(const matrix_base<V>& oth) const;
 
 			template <typename V> auto operator *(const vector_base<V>& vec) const;
-			template <typename V> auto operator *(const vector_base<complex_base<V>>& cvec) const;
-
-			matrix_base& operator +=(const matrix_base<T>& oth);
-			matrix_base& operator -=(const matrix_base<T>& oth);
-
-			template <typename V> auto operator +(const V& value) const;
-			template <typename V> auto operator -(const V& value) const;
-			template <typename V> auto operator *(const V& value) const;
-			template <typename V> auto operator /(const V& value) const;
 
-			template <typename V> auto operator +(const complex_base<V>& value) const;
-			template <typename V> auto operator -(const complex_base<V>& value) const;
-			template <typename V> auto operator *(const complex_base<V>& value) const;
-			template <typename V> auto operator /(const complex_base<V>& value) const;
+			template <typename E, typing::require<typing::is_matrix_operand_v<E>> = 0> matrix_base& operator +=(const E& oth);
+			template <typename E, typing::require<typing::is_matrix_operand_v<E>> = 0> matrix_base& operator -=(const E& oth);
 
 			matrix_base& operator +=(const T& value);
 			matrix_base& operator -=(const T& value);
 			matrix_base& operator *=(const T& value);
 			matrix_base& operator /=(const T& value);
 
-			std::vector<vector_base<T>> base;
+			using value_type = T;
+
+			memory::vector<T> base;		// row-major, element (i, j) is base[i * ld + j]
+			uint128_t nrows;
+			uint128_t ncols;
+			uint128_t ld;			// leading dimension (distance between rows)
 		};
 	}
 
@@ -166,39 +218,11 @@ namespace nm
 		struct is_matrix : bool_constant<is_matrix_v<_Ty>> {};
 	}
 
-	matr32f_t identity_matrix(uint128_t n);
-
-	template <typename T> base_type::matrix_base<T> diagonal(const uint128_t& n, const T& value);
-	template <typename T> base_type::matrix_base<T> diagonal(const base_type::vector_base<T>& values);
-
-	template <typename T> base_type::matrix_base<T> multidiagonal(
-		const uint128_t& n,
-		const std::initializer_list<std::pair<int32_t, T>>& values);
-
-	template <typename T> base_type::matrix_base<T> multidiagonal(
-		const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& diagonals);
-
 	template <typename T> base_type::matrix_base<T> triangulation(const base_type::matrix_base<T>& matr);
 
 	template <typename T> T gauss_determinant(const base_type::matrix_base<T>& matr, bool triangle_check = true);
-
-	// returns C = L + U - E matrix
-	template <typename T> base_type::matrix_base<T> LU_decomposion(const base_type::matrix_base<T>& matr);
-
-	// returns { C = (L + U - E), P } matrices
-	template <typename T> std::tuple<base_type::matrix_base<T>, base_type::matrix_base<T>> LUP_decomposion(const base_type::matrix_base<T>& matr);
 }
 
 template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::matrix_base<T>& matrix);
 
-template <typename T, typename V> auto operator +(const V& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator -(const V& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator *(const V& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator /(const V& value, const nm::base_type::matrix_base<T>& matrix);
-
-template <typename T, typename V> auto operator +(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator -(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator *(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix);
-template <typename T, typename V> auto operator /(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix);
-
 #include "../lib/matrix.inl"
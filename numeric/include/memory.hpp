@@ -0,0 +1,188 @@
+#pragma once
+#include "types.hpp"
+#include <memory_resource>
+
+/***********************************************************************
+ *
+ *		            NumericLib memory declaration file
+ *
+ * Storage of vector_base and matrix_base ('base') is memory::vector<T>,
+ * a std::vector with memory::allocator<T>. The allocator takes its memory
+ * resource (std::pmr::memory_resource) from the calling thread at the
+ * moment the container is created: by default it is the global heap,
+ * inside a 'scope' it is the resource of the scope. So every temporary
+ * of an expression (operator results, copies, 'minor', 'triangulation',
+ * factorization workspaces, ...) can be served by a scratch resource
+ * without changing the code that computes it:
+ *
+ *      nm::memory::arena scratch(1 << 20);
+ *      for (auto& request : requests)
+ *      {
+ *          nm::memory::scope use(scratch);
+ *          ... compute, copy the answer out ...
+ *          scratch.reset();			// all the temporaries at once
+ *      }
+ *
+ * Bundled resources (not thread-safe, keep one per thread):
+ *      arena	- monotonic: bump pointer in large blocks, deallocate does
+ *                nothing, 'reset' drops everything at once
+ *      pool	- size classes of powers of two with free lists, blocks are
+ *                reused after deallocate; requests above 'max_block' go
+ *                to the upstream resource directly
+ *
+ * Every buffer of memory::allocator starts on an ALIGNMENT boundary (a
+ * cache line, one AVX-512 register), so kernels can check 'is_aligned'
+ * and use aligned or non-temporal stores. 'padded_ld' gives a row
+ * distance for matrix_base with padded layout (see 'matrix.hpp'): rows
+ * start on cache lines and are not a large power of two bytes apart,
+ * which would map every row of a column to the same cache set.
+ *
+ * A scope is per thread, the workers of 'parallel.hpp' keep their own
+ * resource (the heap unless they open a scope themselves). A container
+ * remembers its resource: it must not outlive the arena (or its reset),
+ * copies are created in the current resource of the copying thread,
+ * move construction takes the resource along. Assignment never rebinds
+ * a container: 'out = compute(in)' inside a scope keeps 'out' on its own
+ * resource, the elements are copied when the resources differ and the
+ * buffer is stolen only when they are equal. Swapping containers of
+ * different resources is undefined (as for std::pmr), assign instead.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace memory
+	{
+		using resource = std::pmr::memory_resource;
+
+		constexpr uint128_t ALIGNMENT = 64;
+
+		bool is_aligned(const void* p, uint128_t alignment = ALIGNMENT);
+
+		// leading dimension >= n: whole cache lines, an odd count of them
+		// when the row length is a multiple of 8 lines (512 bytes)
+		template <typename T> uint128_t padded_ld(uint128_t n);
+
+		// resource of the calling thread, the heap by default
+		resource* current();
+		resource* exchange(resource* res);
+
+		// makes 'res' current for the calling thread until destroyed
+		class scope
+		{
+		public:
+			scope(resource& res);
+			~scope();
+
+			scope(const scope&) = delete;
+			scope& operator =(const scope&) = delete;
+
+		private:
+			resource* previous;
+		};
+
+		class arena : public resource
+		{
+		public:
+			arena(uint128_t block_size = 1 << 20, resource* upstream = std::pmr::new_delete_resource());
+			~arena();
+
+			arena(const arena&) = delete;
+			arena& operator =(const arena&) = delete;
+
+			// drops every allocation, keeps the newest block for the next round
+			void reset();
+			// returns all the blocks to upstream
+			void release();
+
+			uint128_t used() const;
+			uint128_t capacity() const;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const resource& oth) const noexcept override;
+
+			struct block
+			{
+				block* next;
+				uint128_t size;
+			};
+
+			resource* upstream;
+			uint128_t block_size;
+			block* blocks;			// newest first
+			char* top;
+			char* end;
+			uint128_t nused;
+			uint128_t ncapacity;
+		};
+
+		class pool : public resource
+		{
+		public:
+			pool(uint128_t max_block = 1 << 20, resource* upstream = std::pmr::new_delete_resource());
+			~pool();
+
+			pool(const pool&) = delete;
+			pool& operator =(const pool&) = delete;
+
+			// returns all the chunks to upstream, every block must be free
+			void release();
+
+			uint128_t max_block() const;
+
+		private:
+			void* do_allocate(size_t bytes, size_t alignment) override;
+			void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+			bool do_is_equal(const resource& oth) const noexcept override;
+
+			uint128_t size_class(size_t bytes, size_t alignment) const;
+
+			struct node
+			{
+				node* next;
+			};
+
+			static constexpr uint128_t MIN_BLOCK = 16;
+			static constexpr uint128_t CLASSES = 48;
+
+			resource* upstream;
+			uint128_t nmax;
+			node* lists[CLASSES];		// free blocks of every size class
+			std::vector<std::pair<void*, uint128_t>> chunks;
+		};
+
+		// stateful allocator bound to one resource, copies of a container
+		// are bound to the current resource of the copying thread, a container
+		// never changes its resource on assignment or swap (as the allocator
+		// of std::pmr); allocations are aligned to max(alignof(T), ALIGNMENT)
+		template <typename T>
+		struct allocator
+		{
+			using value_type = T;
+			using propagate_on_container_move_assignment = std::false_type;
+			using propagate_on_container_swap = std::false_type;
+			using propagate_on_container_copy_assignment = std::false_type;
+
+			allocator();
+			allocator(resource* res);
+			template <typename U> allocator(const allocator<U>& oth);
+
+			T* allocate(size_t n);
+			void deallocate(T* p, size_t n);
+
+			allocator select_on_container_copy_construction() const;
+
+			template <typename U> bool operator ==(const allocator<U>& oth) const;
+			template <typename U> bool operator !=(const allocator<U>& oth) const;
+
+			resource* res;
+		};
+
+		template <typename T>
+		using vector = std::vector<T, allocator<T>>;
+	}
+}
+
+#include "../lib/memory.inl"
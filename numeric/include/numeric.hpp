@@ -2,6 +2,25 @@
 #include "dependencies.hpp"
 #include "types.hpp"
 #include "complex.hpp"
+#include "expression.hpp"
+#include "simd.hpp"
+#include "parallel.hpp"
+#include "memory.hpp"
 #include "vector.hpp"
+#include "view.hpp"
+#include "gemm.hpp"
+#include "transpose.hpp"
 #include "matrix.hpp"
+#include "decomposition.hpp"
+#include "solve.hpp"
+#include "banded.hpp"
+#include "structured.hpp"
+#include "iterative.hpp"
+#include "eigen.hpp"
+#include "svd.hpp"
+#include "fft.hpp"
+#include "split.hpp"
+#include "fixed.hpp"
+#include "batched.hpp"
+#include "sparse.hpp"
 #include "operations.hpp"
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include "types.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib parallel declaration file
+ *
+ * Library thread pool, used by matrix products:
+ *      matrix * matrix	- row blocks of the result (see 'gemm.hpp')
+ *      matrix * vector	- row ranges of the result
+ *
+ * Workers are started on first use and live until the program exits.
+ * The calling thread takes part in the work, so 'threads() == 1' means
+ * no workers at all. Nested calls (from inside a task) run serially.
+ *
+ * Settings:
+ *      threads / set_threads			- thread count, by default
+ *                                        std::thread::hardware_concurrency
+ *      serial_cutoff / set_serial_cutoff	- work (multiply-adds) below which
+ *                                        the product runs on one thread
+ *
+ * Settings should be changed while no product is running.
+ * Threading is controlled by PARALLEL_PRODUCT flag (see 'config.hpp').
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace parallel
+	{
+		// default work of one product, below which it runs serially
+		constexpr uint128_t PARALLEL_SERIAL_CUTOFF = 64 * 64 * 64;
+
+		class thread_pool
+		{
+		public:
+			thread_pool(uint128_t nworkers);
+			~thread_pool();
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator =(const thread_pool&) = delete;
+
+			uint128_t size() const;
+
+			// calls task(i) for i in [0, ntasks), returns when all the tasks are done
+			void run(uint128_t ntasks, const std::function<void(uint128_t)>& task);
+
+		private:
+			void worker();
+			void execute();
+
+			std::vector<std::thread> workers;
+			std::mutex busy;
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::condition_variable done;
+
+			const std::function<void(uint128_t)>* job;
+			uint128_t njobs;
+			std::atomic<uint128_t> next;
+			std::atomic<uint128_t> finished;
+			uint128_t active;
+			uint128_t generation;
+			bool stop;
+		};
+
+		uint128_t threads();
+		void set_threads(uint128_t n);
+
+		uint128_t serial_cutoff();
+		void set_serial_cutoff(uint128_t work);
+
+		thread_pool& pool();
+
+		// splits [begin, end) into ranges and calls body(lo, hi) for every
+		// range in parallel, 'work' is the total cost used for the cutoff
+		template <typename F>
+		void parallel_for(uint128_t begin, uint128_t end, uint128_t work, F&& body);
+	}
+}
+
+#include "../lib/parallel.inl"
@@ -0,0 +1,85 @@
+#pragma once
+#include "types.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib simd declaration file
+ *
+ * Runtime dispatched kernels for contiguous float32/float64 arrays:
+ *      sum, dot, sumsq, sumabs, maxabs, max, min	- reductions
+ *      add, sub, scale						- in-place operations
+ *      fill, copy							- stores, non-temporal for buffers of
+ *                                        STREAM_BYTES and more
+ *      transpose							- block transpose by register tiles
+ *      cmul, cdiv, cabs, cscale				- split complex: real and imaginary
+ *                                        parts in two separate arrays
+ *
+ * Instruction set is detected once by CPUID (see 'simd::detect') and
+ * the widest supported one is used: AVX-512, AVX2, SSE2 or plain loops.
+ * It can be lowered by 'simd::set_isa', for example to compare results.
+ *
+ * Kernels are used by vector_base, so there is no need to call them
+ * directly. Dispatch is controlled by SIMD_RUNTIME_DISPATCH flag
+ * (see 'config.hpp').
+ *
+/***********************************************************************/
+
+#if defined(SIMD_RUNTIME_DISPATCH) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define NUMERIC_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+namespace nm
+{
+	namespace simd
+	{
+		enum class isa_t
+		{
+			scalar,
+			sse2,
+			avx2,
+			avx512
+		};
+
+		isa_t detect();
+		isa_t isa();
+		void set_isa(isa_t isa);
+
+		template <typename T> T sum(const T* x, uint128_t n);
+		template <typename T> T dot(const T* x, const T* y, uint128_t n);
+		template <typename T> T sumsq(const T* x, uint128_t n);
+		template <typename T> T sumabs(const T* x, uint128_t n);
+		template <typename T> T maxabs(const T* x, uint128_t n);
+		template <typename T> T max(const T* x, uint128_t n);
+		template <typename T> T min(const T* x, uint128_t n);
+
+		template <typename T> void add(T* x, const T* y, uint128_t n);
+		template <typename T> void sub(T* x, const T* y, uint128_t n);
+		template <typename T> void scale(T* x, T alpha, uint128_t n);
+
+		// larger buffers would only evict the working set from the cache
+		constexpr uint128_t STREAM_BYTES = 1 << 23;
+
+		template <typename T> void fill(T* x, T value, uint128_t n);
+		template <typename T> void copy(T* x, const T* y, uint128_t n);
+
+		// b = a^T, a is m x n, blocks are expected to fit the L1 cache
+		template <typename T> void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb);
+
+		template <typename T> void cmul(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n);
+		template <typename T> void cdiv(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n);
+		template <typename T> void cabs(const T* ar, const T* ai, T* c, uint128_t n);
+		template <typename T> void cscale(T* xr, T* xi, T alpha_re, T alpha_im, uint128_t n);
+	}
+
+	namespace typing
+	{
+		template <typename _Ty>
+		constexpr bool is_simd_v = _Is_any_of_v<remove_cv_t<_Ty>, float32_t, float64_t>;
+	}
+}
+
+#include "../lib/simd.inl"
@@ -0,0 +1,49 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "decomposition.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib solve declaration file
+ *
+ * Linear system solver:
+ *      x = nm::solve(A, b)		- b is vector
+ *      X = nm::solve(A, B)		- columns of B are right-hand sides
+ *
+ * Method is selected by the structure of A (see 'nm::structure'):
+ *      diagonal		- division, O(n * k)
+ *      upper / lower	- back / forward substitution, O(n^2 * k)
+ *      symmetric		- Cholesky, if A is hermitian positive definite
+ *      general			- LU with partial pivoting (see 'decomposition.hpp')
+ *
+ * All right-hand sides of B are solved in one pass, the substitutions
+ * are blocked and run in the gemm kernel (see 'gemm.hpp'). To solve the
+ * same A many times, keep the factorization object: 'nm::lu(A).solve(b)'.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	enum class structure_t
+	{
+		diagonal,
+		upper,
+		lower,
+		symmetric,		// hermitian for complex matrices
+		general
+	};
+
+	template <typename T> structure_t structure(const base_type::matrix_base<T>& matr);
+
+	template <typename T> base_type::vector_base<T> solve(
+		const base_type::matrix_base<T>& matr,
+		const base_type::vector_base<T>& b);
+
+	template <typename T> base_type::matrix_base<T> solve(
+		const base_type::matrix_base<T>& matr,
+		const base_type::matrix_base<T>& b);
+}
+
+#include "../lib/solve.inl"
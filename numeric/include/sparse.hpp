@@ -0,0 +1,127 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "decomposition.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib sparse declaration file
+ *
+ * Base class: sparse_matrix (compressed rows or columns)
+ * Inner type: T (floating or complex)
+ *
+ * Declared types:
+ *      spmatr32f_t =  { float32_t }
+ *      spmatr64f_t =  { float64_t }
+ *      spmatr128f_t = { float128_t }
+ *
+ *      spmatr64c_t =  { complex64_t }
+ *      spmatr128c_t = { complex128_t }
+ *      spmatr256c_t = { complex256_t }
+ *
+ * Only nonzero elements are stored, O(nnz) memory instead of O(m * n):
+ *      csr - rows one after another,    'offsets' has m + 1 elements
+ *      csc - columns one after another, 'offsets' has n + 1 elements
+ * Elements of line k are values[offsets[k] .. offsets[k + 1]), their
+ * column (csr) or row (csc) numbers are in 'indices', sorted ascending.
+ *
+ * Matrix is built from a dense matrix, from (i, j, value) triplets or by
+ * 'sparse_multidiagonal' with the same diagonal specs as 'multidiagonal':
+ *
+ *      auto A = nm::sparse_multidiagonal<float64_t>(n, {{-1, 1.0}, {0, -2.0}, {1, 1.0}});
+ *      auto y = A * x;						// SpMV
+ *      auto z = A.multiply_transposed(x);	// A^T x, no transposed copy
+ *
+ * Products gather along the compressed lines (A * x for csr, A^T * x for
+ * csc) and run on the library thread pool (see 'parallel.hpp'). The other
+ * direction scatters, each thread accumulates into its own buffer.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	enum class sparse_format_t
+	{
+		csr,
+		csc
+	};
+
+	namespace base_type
+	{
+		template <typename T>
+		struct sparse_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value || typing::is_complex<T>::value,
+				"template instantiation of sparse matrix must be floating or complex!"
+				);
+
+			sparse_matrix(uint128_t m = 0, uint128_t n = 0, sparse_format_t format = sparse_format_t::csr);
+			sparse_matrix(const matrix_base<T>& matr, sparse_format_t format = sparse_format_t::csr);
+			sparse_matrix(uint128_t m, uint128_t n,
+				const std::vector<std::tuple<uint128_t, uint128_t, T>>& triplets,
+				sparse_format_t format = sparse_format_t::csr);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+			uint128_t nonzeros() const;
+			sparse_format_t format() const;
+
+			T operator ()(uint128_t i, uint128_t j) const;
+
+			sparse_matrix to_csr() const;
+			sparse_matrix to_csc() const;
+			sparse_matrix transposed() const;
+			matrix_base<T> dense() const;
+
+			template <typename V> auto operator *(const vector_base<V>& vec) const;
+			template <typename V> auto multiply_transposed(const vector_base<V>& vec) const;
+
+			using value_type = T;
+
+			std::vector<uint128_t> offsets;		// start of every compressed line, plus the end
+			std::vector<uint128_t> indices;		// minor index of every element
+			std::vector<T> values;
+			uint128_t nrows;
+			uint128_t ncols;
+			sparse_format_t layout;
+		};
+	}
+
+	typedef base_type::sparse_matrix<float32_t>		spmatr32f_t;
+	typedef base_type::sparse_matrix<float64_t>		spmatr64f_t;
+	typedef base_type::sparse_matrix<float128_t>	spmatr128f_t;
+
+	typedef base_type::sparse_matrix<complex64_t>	spmatr64c_t;
+	typedef base_type::sparse_matrix<complex128_t>	spmatr128c_t;
+	typedef base_type::sparse_matrix<complex256_t>	spmatr256c_t;
+
+	#ifdef BASIC_COMP_TYPE_FLOAT32
+	typedef spmatr32f_t spmatrf_t;
+	typedef spmatr64c_t spmatrc_t;
+	#endif
+	#ifdef BASIC_COMP_TYPE_FLOAT64
+	typedef spmatr64f_t spmatrf_t;
+	typedef spmatr128c_t spmatrc_t;
+	#endif
+	#ifdef BASIC_COMP_TYPE_FLOAT128
+	typedef spmatr128f_t spmatrf_t;
+	typedef spmatr256c_t spmatrc_t;
+	#endif
+
+	template <typename T> base_type::sparse_matrix<T> sparse_multidiagonal(
+		const uint128_t& n,
+		const std::initializer_list<std::pair<int32_t, T>>& values,
+		sparse_format_t format = sparse_format_t::csr);
+
+	template <typename T> base_type::sparse_matrix<T> sparse_multidiagonal(
+		const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& diagonals,
+		sparse_format_t format = sparse_format_t::csr);
+}
+
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::sparse_matrix<T>& matrix);
+
+#include "../lib/sparse.inl"
@@ -0,0 +1,155 @@
+#pragma once
+#include "types.hpp"
+#include "complex.hpp"
+#include "simd.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "gemm.hpp"
+#include "parallel.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib split declaration file
+ *
+ * Complex vectors and matrices in split (structure of arrays) storage:
+ * real and imaginary parts are kept in two separate contiguous arrays
+ * instead of interleaved { real, imag } pairs of complex_base.
+ *
+ * Declared types:
+ *      splitvect64c_t =  { float32_t, float32_t } planes
+ *      splitvect128c_t = { float64_t, float64_t } planes
+ *      splitmatr64c_t, splitmatr128c_t - the same for matrices
+ *
+ * Every complex operation becomes a few real operations on whole
+ * planes, so the SIMD kernels run without shuffles ('cmul', 'cdiv',
+ * 'cabs', 'cscale' at 'simd.hpp'). Matrix product is four real products
+ * of the planes in the gemm kernel (see 'gemm.hpp').
+ * The planes are memory::vector storage like vector_base: aligned to
+ * cache lines and taken from the resource of the current scope (see
+ * 'memory.hpp').
+ *
+ * Storage is opt-in: convert where the heavy arithmetic starts and
+ * convert back at the end, each conversion is one pass:
+ *
+ *      nm::splitvect128c_t s(x);		// x - vect128c_t
+ *      s *= t;							// elementwise
+ *      vect128c_t y = s.interleaved();
+ *
+ * Elements are accessed by value (there is no complex_base to refer to),
+ * 'set' writes one element, 're' / 'im' give the planes directly.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct split_vector
+		{
+			static_assert(
+				typing::is_floating_point<T>::value,
+				"template instantiation of split_vector must be floating!"
+			);
+
+			using value_type = complex_base<T>;
+
+			split_vector(uint128_t n = 0);
+			split_vector(uint128_t n, value_type value);
+			split_vector(const vector_base<value_type>& vect);
+			split_vector(const vector_base<T>& real, const vector_base<T>& imag);
+
+			uint128_t size() const;
+
+			value_type operator [](uint128_t i) const;
+			split_vector& set(uint128_t i, value_type value);
+
+			vector_base<value_type> interleaved() const;
+			operator vector_base<value_type>() const;
+
+			vector_base<T> real() const;
+			vector_base<T> imag() const;
+			vector_base<T> abs() const;
+			split_vector conjugate() const;
+
+			value_type dot(const split_vector& oth) const;		// x^H y
+			T norm2() const;
+
+			split_vector& operator +=(const split_vector& oth);
+			split_vector& operator -=(const split_vector& oth);
+			split_vector& operator *=(const split_vector& oth);	// elementwise
+			split_vector& operator /=(const split_vector& oth);	// elementwise
+
+			split_vector& operator *=(value_type value);
+			split_vector& operator /=(value_type value);
+
+			split_vector operator +(const split_vector& oth) const;
+			split_vector operator -(const split_vector& oth) const;
+			split_vector operator *(const split_vector& oth) const;
+			split_vector operator /(const split_vector& oth) const;
+
+			split_vector operator *(value_type value) const;
+			split_vector operator /(value_type value) const;
+
+			memory::vector<T> re;
+			memory::vector<T> im;
+		};
+
+		template <typename T>
+		struct split_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value,
+				"template instantiation of split_matrix must be floating!"
+			);
+
+			using value_type = complex_base<T>;
+
+			split_matrix(uint128_t m = 0, uint128_t n = 0);
+			split_matrix(const matrix_base<value_type>& matr);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+
+			value_type operator ()(uint128_t i, uint128_t j) const;
+			split_matrix& set(uint128_t i, uint128_t j, value_type value);
+
+			matrix_base<value_type> interleaved() const;
+			operator matrix_base<value_type>() const;
+
+			matrix_base<T> abs() const;
+			split_matrix conjugate() const;			// conjugate transpose, as matrix_base::conjugate
+
+			split_matrix& operator +=(const split_matrix& oth);
+			split_matrix& operator -=(const split_matrix& oth);
+			split_matrix& operator *=(value_type value);
+
+			split_matrix operator +(const split_matrix& oth) const;
+			split_matrix operator -(const split_matrix& oth) const;
+			split_matrix operator *(value_type value) const;
+
+			split_matrix operator *(const split_matrix& oth) const;
+			split_vector<T> operator *(const split_vector<T>& vect) const;
+
+			uint128_t nrows, ncols;
+			memory::vector<T> re;			// row-major, leading dimension = ncols
+			memory::vector<T> im;
+		};
+	}
+
+	typedef base_type::split_vector<float32_t>	splitvect64c_t;
+	typedef base_type::split_vector<float64_t>	splitvect128c_t;
+
+	typedef base_type::split_matrix<float32_t>	splitmatr64c_t;
+	typedef base_type::split_matrix<float64_t>	splitmatr128c_t;
+
+	namespace kernel
+	{
+		// interleaved { real, imag } pairs <-> two planes
+		template <typename T> void deinterleave(const base_type::complex_base<T>* x, T* re, T* im, uint128_t n);
+		template <typename T> void interleave(const T* re, const T* im, base_type::complex_base<T>* x, uint128_t n);
+	}
+}
+
+#include "../lib/split.inl"
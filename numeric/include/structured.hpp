@@ -0,0 +1,183 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib structured declaration file
+ *
+ * Base classes: diagonal_matrix, scalar_matrix, zero_matrix
+ * Inner type: T (floating or complex)
+ *
+ * Matrices, which are defined by a few numbers, keep only these numbers:
+ *      diagonal_matrix	- diag(d_0, ..., d_n-1), O(n) memory
+ *      scalar_matrix	- value * E, O(1) memory, identity is value = 1
+ *      zero_matrix		- m x n zero matrix, O(1) memory
+ *
+ * Returned by:
+ *      nm::diagonal(values)			- diagonal_matrix
+ *      nm::diagonal(n, value)		- scalar_matrix
+ *      nm::identity_matrix<T>(n)	- scalar_matrix, T is float_t by default
+ *      nm::zero_matrix<T>(m, n)		- zero_matrix
+ *
+ * Products and sums with matrix_base/vector_base never build the dense
+ * n x n matrix: D * A scales rows of A, A * D scales columns, A + D adds
+ * to the diagonal only, so the work is the size of the result. Row and
+ * column scaling are also available in place:
+ *
+ *      nm::scale_rows(A, d);		// A = diag(d) * A
+ *      nm::scale_cols(A, d);		// A = A * diag(d)
+ *
+ * Structured matrix converts to matrix_base of any compatible type, when
+ * the dense storage is needed: 'matr64f_t E = nm::identity_matrix<float64_t>(n);'
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct diagonal_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value || typing::is_complex<T>::value,
+				"template instantiation of diagonal matrix must be floating or complex!"
+				);
+
+			diagonal_matrix(uint128_t n = 0, T value = 0);
+			diagonal_matrix(const vector_base<T>& values);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+
+			T operator ()(uint128_t i, uint128_t j) const;
+
+			T det() const;
+			diagonal_matrix inversed() const;
+
+			vector_base<T> solve(const vector_base<T>& b) const;
+			matrix_base<T> solve(const matrix_base<T>& b) const;
+
+			template <typename V = T> matrix_base<V> dense() const;
+			template <typename V> operator matrix_base<V>() const;
+
+			using value_type = T;
+
+			vector_base<T> values;
+		};
+
+		template <typename T>
+		struct scalar_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value || typing::is_complex<T>::value,
+				"template instantiation of scalar matrix must be floating or complex!"
+				);
+
+			scalar_matrix(uint128_t n = 0, T value = 1);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+
+			T operator ()(uint128_t i, uint128_t j) const;
+
+			T det() const;
+			scalar_matrix inversed() const;
+
+			template <typename V = T> matrix_base<V> dense() const;
+			template <typename V> operator matrix_base<V>() const;
+
+			using value_type = T;
+
+			uint128_t n;
+			T value;
+		};
+
+		template <typename T>
+		struct zero_matrix
+		{
+			static_assert(
+				typing::is_floating_point<T>::value || typing::is_complex<T>::value,
+				"template instantiation of zero matrix must be floating or complex!"
+				);
+
+			zero_matrix(uint128_t m = 0, uint128_t n = 0);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+
+			T operator ()(uint128_t i, uint128_t j) const;
+
+			template <typename V = T> matrix_base<V> dense() const;
+			template <typename V> operator matrix_base<V>() const;
+
+			using value_type = T;
+
+			uint128_t nrows;
+			uint128_t ncols;
+		};
+
+		template <typename T> vector_base<T> operator *(const diagonal_matrix<T>& diag, const vector_base<T>& vect);
+		template <typename T> matrix_base<T> operator *(const diagonal_matrix<T>& diag, const matrix_base<T>& matr);
+		template <typename T> matrix_base<T> operator *(const matrix_base<T>& matr, const diagonal_matrix<T>& diag);
+		template <typename T> diagonal_matrix<T> operator *(const diagonal_matrix<T>& lhs, const diagonal_matrix<T>& rhs);
+
+		template <typename T> matrix_base<T> operator +(const matrix_base<T>& matr, const diagonal_matrix<T>& diag);
+		template <typename T> matrix_base<T> operator +(const diagonal_matrix<T>& diag, const matrix_base<T>& matr);
+		template <typename T> matrix_base<T> operator -(const matrix_base<T>& matr, const diagonal_matrix<T>& diag);
+		template <typename T> matrix_base<T> operator -(const diagonal_matrix<T>& diag, const matrix_base<T>& matr);
+
+		template <typename T> vector_base<T> operator *(const scalar_matrix<T>& scal, const vector_base<T>& vect);
+		template <typename T> matrix_base<T> operator *(const scalar_matrix<T>& scal, const matrix_base<T>& matr);
+		template <typename T> matrix_base<T> operator *(const matrix_base<T>& matr, const scalar_matrix<T>& scal);
+		template <typename T> diagonal_matrix<T> operator *(const scalar_matrix<T>& scal, const diagonal_matrix<T>& diag);
+		template <typename T> diagonal_matrix<T> operator *(const diagonal_matrix<T>& diag, const scalar_matrix<T>& scal);
+		template <typename T> scalar_matrix<T> operator *(const scalar_matrix<T>& lhs, const scalar_matrix<T>& rhs);
+
+		template <typename T> matrix_base<T> operator +(const matrix_base<T>& matr, const scalar_matrix<T>& scal);
+		template <typename T> matrix_base<T> operator +(const scalar_matrix<T>& scal, const matrix_base<T>& matr);
+		template <typename T> matrix_base<T> operator -(const matrix_base<T>& matr, const scalar_matrix<T>& scal);
+		template <typename T> matrix_base<T> operator -(const scalar_matrix<T>& scal, const matrix_base<T>& matr);
+
+		template <typename T> vector_base<T> operator *(const zero_matrix<T>& zero, const vector_base<T>& vect);
+		template <typename T> zero_matrix<T> operator *(const zero_matrix<T>& zero, const matrix_base<T>& matr);
+		template <typename T> zero_matrix<T> operator *(const matrix_base<T>& matr, const zero_matrix<T>& zero);
+
+		template <typename T> matrix_base<T> operator +(const matrix_base<T>& matr, const zero_matrix<T>& zero);
+		template <typename T> matrix_base<T> operator +(const zero_matrix<T>& zero, const matrix_base<T>& matr);
+		template <typename T> matrix_base<T> operator -(const matrix_base<T>& matr, const zero_matrix<T>& zero);
+		template <typename T> matrix_base<T> operator -(const zero_matrix<T>& zero, const matrix_base<T>& matr);
+	}
+
+	template <typename T = float_t> base_type::scalar_matrix<T> identity_matrix(uint128_t n);
+	template <typename T = float_t> base_type::zero_matrix<T> zero_matrix(uint128_t m, uint128_t n);
+
+	template <typename T> base_type::scalar_matrix<T> diagonal(const uint128_t& n, const T& value);
+	template <typename T> base_type::diagonal_matrix<T> diagonal(const base_type::vector_base<T>& values);
+
+	// row i of matr is multiplied by d[i]
+	template <typename T> base_type::matrix_base<T>& scale_rows(base_type::matrix_base<T>& matr, const base_type::vector_base<T>& d);
+
+	// column j of matr is multiplied by d[j]
+	template <typename T> base_type::matrix_base<T>& scale_cols(base_type::matrix_base<T>& matr, const base_type::vector_base<T>& d);
+
+	template <typename T> base_type::vector_base<T> solve(
+		const base_type::diagonal_matrix<T>& matr,
+		const base_type::vector_base<T>& b);
+
+	template <typename T> base_type::matrix_base<T> solve(
+		const base_type::diagonal_matrix<T>& matr,
+		const base_type::matrix_base<T>& b);
+}
+
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::diagonal_matrix<T>& matrix);
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::scalar_matrix<T>& matrix);
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::zero_matrix<T>& matrix);
+
+#include "../lib/structured.inl"
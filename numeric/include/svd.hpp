@@ -0,0 +1,85 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "decomposition.hpp"
+#include "eigen.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib svd declaration file
+ *
+ * Singular value decomposition of any m x n matrix, k = min(m, n):
+ *      A = U diag(s) V^H, s is real, nonnegative and sorted descending
+ *
+ *      auto f = nm::svd(A);						// thin: U is m x k, V is n x k
+ *      auto f = nm::svd(A, nm::svd_mode_t::full);	// U is m x m, V is n x n
+ *      auto s = nm::svdvals(A);					// values only
+ *
+ * A is reduced to a real upper bidiagonal B = Q^H A P by Householder
+ * reflections from both sides: every step makes one pass over the rows
+ * of the trailing matrix, which applies the left reflector and the right
+ * one at once, the pass is split between threads. B is diagonalized by
+ * the implicit QR iteration with Wilkinson shift (Golub-Kahan).
+ *
+ * Tall matrices (m >= 2n) are factorized by QR first, then only the
+ * n x n R is bidiagonalized, U = Q U_R. Wide matrices are handled as
+ * A^H. Values-only mode never touches U and V, thin mode never forms the
+ * m x m U, the reflectors are applied to the m x k matrix only. Rotations
+ * of the QR sweeps are applied in cache-sized column blocks (threaded).
+ *
+ * Decomposition object computes the pseudo-inverse, rank and condition
+ * number; 'nm::pinv', 'nm::rank' and 'nm::cond' are one-shot versions.
+ * Singular values below tolerance = max(m, n) * eps * s_max are treated
+ * as zero.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	enum class svd_mode_t
+	{
+		full,
+		thin,
+		values
+	};
+
+	namespace base_type
+	{
+		template <typename T>
+		struct svd_base
+		{
+			using real_t = typing::real_type_t<T>;
+
+			svd_base(const matrix_base<T>& matr, svd_mode_t mode = svd_mode_t::thin);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			bool is_converged() const;
+
+			real_t tolerance() const;					// default threshold of a zero singular value
+			uint128_t rank() const;
+			uint128_t rank(real_t tolerance) const;
+			real_t cond() const;						// s_max / s_min, infinity if A is rank deficient
+			real_t norm2() const;						// s_max
+
+			matrix_base<T> pinv() const;				// n x m, not available in values-only mode
+			matrix_base<T> pinv(real_t tolerance) const;
+
+			vector_base<real_t> values;					// descending, min(m, n)
+			matrix_base<T> u;							// columns - left singular vectors, empty in values-only mode
+			matrix_base<T> v;							// columns - right singular vectors (not V^H)
+			uint128_t nrows, ncols;
+			bool converged;
+		};
+	}
+
+	template <typename T> base_type::svd_base<T> svd(const base_type::matrix_base<T>& matr, svd_mode_t mode = svd_mode_t::thin);
+	template <typename T> base_type::vector_base<typing::real_type_t<T>> svdvals(const base_type::matrix_base<T>& matr);
+
+	template <typename T> base_type::matrix_base<T> pinv(const base_type::matrix_base<T>& matr);
+	template <typename T> uint128_t rank(const base_type::matrix_base<T>& matr);
+	template <typename T> typing::real_type_t<T> cond(const base_type::matrix_base<T>& matr);
+}
+
+#include "../lib/svd.inl"
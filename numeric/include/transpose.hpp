@@ -0,0 +1,51 @@
+#pragma once
+#include "types.hpp"
+#include "simd.hpp"
+#include "memory.hpp"
+#include "parallel.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib transpose declaration file
+ *
+ * Transposition kernels for row-major storage with leading dimensions:
+ *      transpose			- B = A^T, out of place
+ *      transpose_square	- A = A^T in place, A is n x n
+ *      transpose_cycles	- A = A^T in place, A is packed m x n
+ *
+ * Out of place transposition is cache-oblivious: the larger dimension
+ * is halved until a source block and its destination fit the L1 cache
+ * (TRANSPOSE_BLOCK), so every cache line is read and written once at
+ * any cache size. Leaf blocks are transposed by register tiles (4 x 4,
+ * 8 x 8 for float32 / float64, see 'simd::transpose').
+ *
+ * In place square transposition swaps the blocks above the diagonal
+ * with the blocks below through one block of workspace. A rectangular
+ * packed matrix is permuted by cycles: element p moves to p * m mod
+ * (m * n - 1), one bit of workspace per element marks moved ones. It is
+ * slower (cache miss per element), but does not double the memory.
+ *
+ * The kernels are used by matrix_base::transpose and 'transposed'.
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace kernel
+	{
+		// a source and a destination block of float64_t take 16 Kb
+		constexpr uint128_t TRANSPOSE_BLOCK = 32;
+
+		template <typename T>
+		void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb);
+
+		template <typename T>
+		void transpose_square(uint128_t n, T* a, uint128_t lda);
+
+		// a is m x n with lda = n, the result is n x m with lda = m
+		template <typename T>
+		void transpose_cycles(uint128_t m, uint128_t n, T* a);
+	}
+}
+
+#include "../lib/transpose.inl"
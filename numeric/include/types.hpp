@@ -61,6 +61,7 @@ namespace nm
 		using std::is_integral;
 		using std::is_arithmetic;
 		using std::is_floating_point;
+		using std::is_same_v;
 
 		using std::enable_if_t;
 		using std::conditional_t;
@@ -1,12 +1,15 @@
 #pragma once
 #include "types.hpp"
 #include "complex.hpp"
+#include "expression.hpp"
+#include "simd.hpp"
+#include "memory.hpp"
 
 /***********************************************************************
  *
  *		            NumericLib vector declaration file
  *
- * Base class: vector_base (std::vector)
+ * Base class: vector_base (memory::vector, see 'memory.hpp')
  * Inner type: T (any)
  * 
  * Declared types:
@@ -23,6 +26,11 @@
  * Anyway, you always can create new operator override by hand, but there are
  * no guarantess that library would be working properly with user types.
  * 
+ * Arithmetic operators are lazy and evaluated in one pass (see 'expression.hpp').
+ * Reductions (sum, norms, dot, max, min) and in-place operations on float32
+ * and float64 vectors use SIMD kernels, selected at runtime (see 'simd.hpp').
+ * Storage starts on a cache line ('is_aligned', see 'memory.hpp').
+ *
  * Basic operations, such as 'abs', 'norm', 'dot', etc declared at 'operations.hpp'.
  * There also defined literal override, which makes it possible to use 'N'
  * literal to define a vector size N, filled by 1. Example: vect_t v = 10N.
@@ -36,6 +44,12 @@ namespace nm
 		template <typename T>
 		struct matrix_base;
 
+		template <typename T>
+		struct vector_view;
+
+		template <typename T>
+		struct matrix_view;
+
 		template <typename T>
 		struct vector_base
 		{
@@ -49,13 +63,24 @@ namespace nm
 			vector_base(const std::vector<T>& stdvect);
 			vector_base(const std::initializer_list<T>& rawvect);
 
+			template <typename L, typename R, typename Op>
+			vector_base(const vector_expr<L, R, Op>& expr);
+
+			template <typename L, typename R, typename Op>
+			vector_base& operator =(const vector_expr<L, R, Op>& expr);
+
 			vector_base<T>& fill(T value);
 
 			uint128_t size() const;
+			bool is_aligned() const;
 			T& operator [](int32_t i);
 			const T& operator [](int32_t i) const;
 
-			vector_base<T> slice(int32_t beg, int32_t end, uint32_t step = 1) const;
+			vector_view<T> view();
+			vector_view<const T> view() const;
+
+			vector_view<T> slice(int32_t beg, int32_t end, uint32_t step = 1);
+			vector_view<const T> slice(int32_t beg, int32_t end, uint32_t step = 1) const;
 
 			vector_base<T>& sort(bool ascend = true);
 			vector_base<T> sorted(bool ascend = true) const;
@@ -79,30 +104,17 @@ namespace nm
 			template <typename V> auto dot(const matrix_base<V>& mat) const;
 			template <typename V> auto cross(const vector_base<V>& oth) const;
 
-			vector_base operator -() const;
-
-			template <typename V> auto operator +(const vector_base<V>& oth) const;
-			template <typename V> auto operator -(const vector_base<V>& oth) const;
-
-			vector_base& operator +=(const vector_base<T>& oth);
-			vector_base& operator -=(const vector_base<T>& oth);
-
-			template <typename V> auto operator +(const V& value) const;
-			template <typename V> auto operator -(const V& value) const;
-			template <typename V> auto operator *(const V& value) const;
-			template <typename V> auto operator /(const V& value) const;
-
-			template <typename V> auto operator +(const complex_base<V>& value) const;
-			template <typename V> auto operator -(const complex_base<V>& value) const;
-			template <typename V> auto operator *(const complex_base<V>& value) const;
-			template <typename V> auto operator /(const complex_base<V>& value) const;
+			template <typename E, typing::require<typing::is_vector_operand_v<E>> = 0> vector_base& operator +=(const E& oth);
+			template <typename E, typing::require<typing::is_vector_operand_v<E>> = 0> vector_base& operator -=(const E& oth);
 
 			vector_base& operator +=(const T& value);
 			vector_base& operator -=(const T& value);
 			vector_base& operator *=(const T& value);
 			vector_base& operator /=(const T& value);
 
-			std::vector<T> base;
+			using value_type = T;
+
+			memory::vector<T> base;
 		};
 	}
 
@@ -156,16 +168,6 @@ namespace nm
 
 template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::vector_base<T>& vector);
 
-template <typename T, typename V> auto operator +(const V& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator -(const V& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator *(const V& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator /(const V& value, const nm::base_type::vector_base<T>& vector);
-
-template <typename T, typename V> auto operator +(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator -(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator *(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector);
-template <typename T, typename V> auto operator /(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector);
-
 #include "../lib/vector.inl"
 
 
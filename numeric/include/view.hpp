@@ -0,0 +1,161 @@
+#pragma once
+#include "types.hpp"
+#include "vector.hpp"
+
+/***********************************************************************
+ *
+ *		            NumericLib view declaration file
+ *
+ * Base classes: vector_view, matrix_view (non-owning)
+ * Inner type: T (any, const-qualified for read-only views)
+ *
+ * View is a strided pointer into the storage of other object and it
+ * never allocates. Views are returned by:
+ *      vector_base::slice
+ *      matrix_base::row, col, diagonal, slice, operator[]
+ *
+ * Assignment to the view copies elements into the referenced storage,
+ * so 'matr[0] = vect', 'matr.col(1) = matr.col(2)' and in-place
+ * operations like 'matr.col(3) *= 2' modify the parent object. Views
+ * can be used as operands of arithmetic (see 'expression.hpp').
+ * Step may be negative, then view walks the parent storage backwards.
+ *
+ * Source and destination may overlap: 'v.slice(1, 4) = v.slice(0, 3)'
+ * shifts the elements, 'v.slice(1, 4) += v.slice(0, 3)' adds the old
+ * values and 'Q = Q.transposed() + Q' transposes the old values. This
+ * holds for '=', '+=' and '-='. Views with the same step are updated in
+ * the safe direction, other overlapping operands are evaluated into a
+ * temporary first.
+ *
+ * View is valid while the parent storage is alive and not resized.
+ * To get an independent copy convert it to vector_base/matrix_base:
+ *      vect_t column = matr.col(0);
+ *
+/***********************************************************************/
+
+namespace nm
+{
+	namespace base_type
+	{
+		template <typename T>
+		struct vector_view
+		{
+			using value_type = typing::remove_cv_t<T>;
+
+			struct iterator
+			{
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = typing::remove_cv_t<T>;
+				using difference_type = std::ptrdiff_t;
+				using pointer = T*;
+				using reference = T&;
+
+				T& operator *() const { return *ptr; }
+				T* operator ->() const { return ptr; }
+				iterator& operator ++() { ptr += step; return *this; }
+				iterator operator ++(int) { auto it = *this; ptr += step; return it; }
+				bool operator ==(const iterator& oth) const { return ptr == oth.ptr; }
+				bool operator !=(const iterator& oth) const { return ptr != oth.ptr; }
+
+				T* ptr;
+				int128_t step;
+			};
+
+			vector_view(T* ptr = nullptr, uint128_t n = 0, int128_t step = 1);
+
+			template <typename V>
+			vector_view(const vector_view<V>& oth);
+
+			vector_view& operator =(const vector_view& oth);
+			template <typename V>
+			vector_view& operator =(const vector_view<V>& oth);
+			vector_view& operator =(const vector_base<value_type>& vect);
+			template <typename L, typename R, typename Op>
+			vector_view& operator =(const vector_expr<L, R, Op>& expr);
+
+			vector_view& fill(const value_type& value);
+
+			uint128_t size() const;
+			T& operator [](int32_t i) const;
+
+			iterator begin() const;
+			iterator end() const;
+
+			vector_view slice(int32_t beg, int32_t end, uint32_t step = 1) const;
+
+			value_type max() const;
+			value_type min() const;
+			value_type sum() const;
+
+			template <typename V> auto dot(const vector_view<V>& oth) const;
+			template <typename V> auto dot(const vector_base<V>& oth) const;
+
+			template <typename V> vector_view& operator +=(const V& oth);
+			template <typename V> vector_view& operator -=(const V& oth);
+
+			vector_view& operator *=(const value_type& value);
+			vector_view& operator /=(const value_type& value);
+
+			operator vector_base<value_type>() const;
+
+			T* base;
+			uint128_t n;
+			int128_t step;
+		};
+
+		template <typename T>
+		struct matrix_view
+		{
+			using value_type = typing::remove_cv_t<T>;
+
+			matrix_view(T* ptr = nullptr, uint128_t m = 0, uint128_t n = 0, int128_t rstep = 0, int128_t cstep = 1);
+
+			template <typename V>
+			matrix_view(const matrix_view<V>& oth);
+
+			matrix_view& operator =(const matrix_view& oth);
+			template <typename V>
+			matrix_view& operator =(const matrix_view<V>& oth);
+			matrix_view& operator =(const matrix_base<value_type>& matr);
+			template <typename L, typename R, typename Op>
+			matrix_view& operator =(const matrix_expr<L, R, Op>& expr);
+
+			matrix_view& fill(const value_type& value);
+
+			uint128_t rows() const;
+			uint128_t cols() const;
+			std::pair<uint128_t, uint128_t> size() const;
+
+			T& operator ()(uint128_t i, uint128_t j) const;
+
+			vector_view<T> row(int i) const;
+			vector_view<T> col(int i) const;
+			vector_view<T> diagonal(int i) const;
+			vector_view<T> operator [](int i) const;
+
+			matrix_view slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend,
+				uint32_t rstep = 1, uint32_t cstep = 1) const;
+
+			matrix_view transposed() const;
+
+			template <typename V> matrix_view& operator +=(const V& oth);
+			template <typename V> matrix_view& operator -=(const V& oth);
+
+			matrix_view& operator *=(const value_type& value);
+			matrix_view& operator /=(const value_type& value);
+
+			operator matrix_base<value_type>() const;
+
+			T* base;
+			uint128_t m;
+			uint128_t n;
+			int128_t rstep;
+			int128_t cstep;
+		};
+	}
+}
+
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::vector_view<T>& view);
+template <typename T> std::ostream& operator <<(std::ostream& out, const nm::base_type::matrix_view<T>& view);
+
+#include "../lib/view.inl"
@@ -0,0 +1,485 @@
+#include "../include/banded.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// tridiagonal solve of k right-hand sides (rows of b), lower / upper may be null for zero diagonals
+		template<typename T>
+		inline void thomas(uint128_t n, uint128_t k, const T* lower, const T* diag, const T* upper, T* b, uint128_t ldb)
+		{
+			if (n == 0)
+				return;
+
+			// forward sweep: eliminate the subdiagonal, c keeps the new superdiagonal
+			std::vector<T> c(n, T(0));
+			T pivot = T(1) / diag[0];
+			if (upper && n > 1)
+				c[0] = upper[0] * pivot;
+			for (uint128_t t = 0; t < k; t++)
+				b[t] *= pivot;
+
+			for (uint128_t i = 1; i < n; i++)
+			{
+				T l = lower ? lower[i - 1] : T(0);
+				pivot = T(1) / (diag[i] - l * c[i - 1]);
+				if (upper && i + 1 < n)
+					c[i] = upper[i] * pivot;
+
+				T* row = b + i * ldb;
+				const T* prev = row - ldb;
+				for (uint128_t t = 0; t < k; t++)
+					row[t] = (row[t] - l * prev[t]) * pivot;
+			}
+
+			// back substitution
+			for (uint128_t i = n - 1; i-- > 0;)
+				row_axpy(k, -c[i], b + (i + 1) * ldb, b + i * ldb);
+		}
+
+		// y = A x, A in band storage, rows are split between threads
+		template<typename TS, typename T, typename V>
+		inline void band_gemv(uint128_t n, uint128_t kl, uint128_t ku, const T* a, uint128_t lda, const V* x, TS* y)
+		{
+			parallel::parallel_for(0, n, n * (kl + ku + 1), [&](uint128_t lo, uint128_t hi)
+			{
+				std::fill(y + lo, y + hi, TS(0));
+
+				// diagonal by diagonal, so both operands are read contiguously
+				for (int128_t d = -int128_t(kl); d <= int128_t(ku); d++)
+				{
+					const T* diag = a + (ku - d) * lda;
+					auto beg = std::max<int128_t>(lo, -d);
+					auto end = std::min<int128_t>(hi, n - d);
+					for (auto i = beg; i < end; i++)
+						y[i] += diag[i + d] * x[i + d];
+				}
+			});
+		}
+
+		// partial pivoting LU of band storage with kl + ku rows above the diagonal,
+		// A(i, j) = a[(kl + ku + i - j) * lda + j]; returns false on zero pivot
+		template<typename T>
+		inline bool band_lu(uint128_t n, uint128_t kl, uint128_t ku, T* a, uint128_t lda, uint128_t* perm, int32_t& sign)
+		{
+			auto kv = kl + ku;
+			auto at = [=](uint128_t i, uint128_t j) -> T& { return a[(kv + i - j) * lda + j]; };
+
+			bool regular = true;
+			sign = 1;
+			for (uint128_t j = 0; j < n; j++)
+			{
+				auto km = std::min(kl, n - 1 - j);
+				auto ju = std::min(j + kv, n - 1);
+
+				uint128_t p = j;
+				auto pmax = nm::abs(at(j, j));
+				for (auto i = j + 1; i <= j + km; i++)
+				{
+					auto value = nm::abs(at(i, j));
+					if (value > pmax)
+					{
+						p = i;
+						pmax = value;
+					}
+				}
+
+				perm[j] = p;
+				if (pmax == 0)
+				{
+					regular = false;
+					continue;
+				}
+
+				// rows j and p share the columns [j, ju] of the band, fill-in stays inside kl + ku superdiagonals
+				if (p != j)
+				{
+					for (auto c = j; c <= ju; c++)
+						std::swap(at(j, c), at(p, c));
+					sign = -sign;
+				}
+
+				T pivot = T(1) / at(j, j);
+				for (auto i = j + 1; i <= j + km; i++)
+				{
+					T mul = at(i, j) *= pivot;
+					for (auto c = j + 1; c <= ju; c++)
+						at(i, c) -= mul * at(j, c);
+				}
+			}
+			return regular;
+		}
+
+		// solve of k right-hand sides (rows of b) with the factor of 'band_lu'
+		template<typename T>
+		inline void band_lu_solve(uint128_t n, uint128_t k, uint128_t kl, uint128_t ku, const T* a, uint128_t lda, const uint128_t* perm, T* b, uint128_t ldb)
+		{
+			auto kv = kl + ku;
+			auto at = [=](uint128_t i, uint128_t j) { return a[(kv + i - j) * lda + j]; };
+
+			// L y = P b, row swaps are applied in the order of the factorization
+			for (uint128_t j = 0; j < n; j++)
+			{
+				if (perm[j] != j)
+					std::swap_ranges(b + j * ldb, b + j * ldb + k, b + perm[j] * ldb);
+
+				auto km = std::min(kl, n - 1 - j);
+				for (auto i = j + 1; i <= j + km; i++)
+					row_axpy(k, -at(i, j), b + j * ldb, b + i * ldb);
+			}
+
+			// U x = y
+			for (uint128_t i = n; i-- > 0;)
+			{
+				T* row = b + i * ldb;
+				auto ju = std::min(i + kv, n - 1);
+				for (auto c = i + 1; c <= ju; c++)
+					row_axpy(k, -at(i, c), b + c * ldb, row);
+
+				T pivot = T(1) / at(i, i);
+				for (uint128_t t = 0; t < k; t++)
+					row[t] *= pivot;
+			}
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline band_matrix<T>::band_matrix(uint128_t n, uint128_t kl, uint128_t ku) :
+			band(kl + ku + 1, n),
+			kl(kl),
+			ku(ku)
+		{
+		}
+
+		template<typename T>
+		inline band_matrix<T>::band_matrix(const matrix_base<T>& matr, uint128_t kl, uint128_t ku) :
+			band_matrix(matr.rows(), kl, ku)
+		{
+			assert(matr.is_square());
+			auto n = matr.rows();
+			for (int128_t d = -int128_t(kl); d <= int128_t(ku); d++)
+				for (int128_t i = std::max<int128_t>(0, -d); i < std::min<int128_t>(n, n - d); i++)
+					band(ku - d, i + d) = matr(i, i + d);
+		}
+
+		template<typename T>
+		inline uint128_t band_matrix<T>::rows() const
+		{
+			return band.cols();
+		}
+
+		template<typename T>
+		inline uint128_t band_matrix<T>::cols() const
+		{
+			return band.cols();
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> band_matrix<T>::size() const
+		{
+			return std::make_pair(rows(), cols());
+		}
+
+		template<typename T>
+		inline uint128_t band_matrix<T>::lower_bandwidth() const
+		{
+			return kl;
+		}
+
+		template<typename T>
+		inline uint128_t band_matrix<T>::upper_bandwidth() const
+		{
+			return ku;
+		}
+
+		template<typename T>
+		inline bool band_matrix<T>::is_tridiagonal() const
+		{
+			return kl <= 1 && ku <= 1;
+		}
+
+		template<typename T>
+		inline bool band_matrix<T>::is_diagonally_dominant() const
+		{
+			auto n = rows();
+			for (uint128_t i = 0; i < n; i++)
+			{
+				typing::real_type_t<T> sum = 0;
+				auto beg = i > kl ? i - kl : 0;
+				auto end = std::min(i + ku + 1, n);
+				for (auto j = beg; j < end; j++)
+					if (j != i)
+						sum += nm::abs(band(ku + i - j, j));
+
+				auto d = nm::abs(band(ku, i));
+				if (d == 0 || d < sum)
+					return false;
+			}
+			return true;
+		}
+
+		template<typename T>
+		inline T& band_matrix<T>::operator()(uint128_t i, uint128_t j)
+		{
+			assert(i < rows() && j < cols() && i <= j + kl && j <= i + ku);
+			return band(ku + i - j, j);
+		}
+
+		template<typename T>
+		inline T band_matrix<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			assert(i < rows() && j < cols());
+			if (i > j + kl || j > i + ku)
+				return T(0);
+			return band(ku + i - j, j);
+		}
+
+		template<typename T>
+		inline vector_view<T> band_matrix<T>::diagonal(int32_t index)
+		{
+			assert(-index <= int128_t(kl) && index <= int128_t(ku));
+			uint128_t shift = std::min<uint128_t>(std::abs(index), rows());
+			return vector_view<T>(band.data() + (ku - index) * band.ld + (index > 0 ? shift : 0), rows() - shift);
+		}
+
+		template<typename T>
+		inline vector_view<const T> band_matrix<T>::diagonal(int32_t index) const
+		{
+			assert(-index <= int128_t(kl) && index <= int128_t(ku));
+			uint128_t shift = std::min<uint128_t>(std::abs(index), rows());
+			return vector_view<const T>(band.data() + (ku - index) * band.ld + (index > 0 ? shift : 0), rows() - shift);
+		}
+
+		template<typename T>
+		inline band_matrix<T>& band_matrix<T>::fill_diagonal(T value, int32_t index)
+		{
+			diagonal(index).fill(value);
+			return *this;
+		}
+
+		template<typename T>
+		inline band_matrix<T>& band_matrix<T>::fill_diagonal(const vector_base<T>& values, int32_t index)
+		{
+			auto view = diagonal(index);
+			assert(values.size() == view.size());
+			view = values;
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_base<T> band_matrix<T>::dense() const
+		{
+			auto n = rows();
+			matrix_base<T> result(n, n);
+			for (int128_t d = -int128_t(kl); d <= int128_t(ku); d++)
+				for (int128_t i = std::max<int128_t>(0, -d); i < std::min<int128_t>(n, n - d); i++)
+					result(i, i + d) = band(ku - d, i + d);
+			return result;
+		}
+
+		template<typename T>
+		inline band_matrix<T>::operator matrix_base<T>() const
+		{
+			return dense();
+		}
+
+		template<typename T>
+		template<typename V>
+		inline auto band_matrix<T>::operator*(const vector_base<V>& vec) const
+		{
+			auto n = rows();
+			assert(n == vec.size());
+
+			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
+			vector_base<TS> result(n);
+			kernel::band_gemv(n, kl, ku, band.data(), band.ld, vec.base.data(), result.base.data());
+			return result;
+		}
+
+		template<typename T>
+		inline band_lu_base<T> band_matrix<T>::lu() const
+		{
+			return band_lu_base<T>(*this);
+		}
+
+		template<typename T>
+		inline vector_base<T> band_matrix<T>::solve(const vector_base<T>& b) const
+		{
+			auto n = rows();
+			assert(b.size() == n);
+			if (!is_tridiagonal() || !is_diagonally_dominant())
+				return lu().solve(b);
+
+			// no pivoting is needed for diagonally dominant matrices
+			vector_base<T> x(b);
+			const T* a = band.data();
+			auto ld = band.ld;
+			kernel::thomas<T>(n, 1, kl ? a + (ku + 1) * ld : nullptr, a + ku * ld, ku ? a + 1 : nullptr, x.base.data(), 1);
+			return x;
+		}
+
+		template<typename T>
+		inline matrix_base<T> band_matrix<T>::solve(const matrix_base<T>& b) const
+		{
+			auto n = rows();
+			assert(b.rows() == n);
+			if (!is_tridiagonal() || !is_diagonally_dominant())
+				return lu().solve(b);
+
+			matrix_base<T> x(b);
+			const T* a = band.data();
+			auto ld = band.ld;
+			kernel::thomas<T>(n, x.cols(), kl ? a + (ku + 1) * ld : nullptr, a + ku * ld, ku ? a + 1 : nullptr, x.data(), x.ld);
+			return x;
+		}
+
+		template<typename T>
+		inline band_lu_base<T>::band_lu_base(const band_matrix<T>& matr) :
+			lu(2 * matr.kl + matr.ku + 1, matr.rows()),
+			perm(matr.rows()),
+			kl(matr.kl),
+			ku(matr.ku)
+		{
+			// first kl rows are kept for the fill-in of the row swaps
+			auto n = matr.rows();
+			std::copy_n(matr.band.data(), (kl + ku + 1) * n, lu.data() + kl * lu.ld);
+			singular = !kernel::band_lu(n, kl, ku, lu.data(), lu.ld, perm.data(), sign);
+		}
+
+		template<typename T>
+		inline uint128_t band_lu_base<T>::size() const
+		{
+			return lu.cols();
+		}
+
+		template<typename T>
+		inline bool band_lu_base<T>::is_singular() const
+		{
+			return singular;
+		}
+
+		template<typename T>
+		inline T band_lu_base<T>::det() const
+		{
+			if (singular)
+				return 0;
+
+			T result = sign;
+			for (uint128_t i = 0; i < size(); i++)
+				result *= lu(kl + ku, i);
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T> band_lu_base<T>::solve(const vector_base<T>& b) const
+		{
+			vector_base<T> x(b);
+			return solve_inplace(x);
+		}
+
+		template<typename T>
+		inline matrix_base<T> band_lu_base<T>::solve(const matrix_base<T>& b) const
+		{
+			matrix_base<T> x(b);
+			return solve_inplace(x);
+		}
+
+		template<typename T>
+		inline vector_base<T>& band_lu_base<T>::solve_inplace(vector_base<T>& b) const
+		{
+			assert(!singular && b.size() == size());
+			kernel::band_lu_solve(size(), 1, kl, ku, lu.data(), lu.ld, perm.data(), b.base.data(), 1);
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& band_lu_base<T>::solve_inplace(matrix_base<T>& b) const
+		{
+			assert(!singular && b.rows() == size());
+			kernel::band_lu_solve(size(), b.cols(), kl, ku, lu.data(), lu.ld, perm.data(), b.data(), b.ld);
+			return b;
+		}
+	}
+
+	template<typename T>
+	base_type::band_matrix<T> multidiagonal(const uint128_t& n, const std::initializer_list<std::pair<int32_t, T>>& values)
+	{
+		int32_t lower = 0, upper = 0;
+		for (auto& pair : values)
+		{
+			lower = std::max(lower, -pair.first);
+			upper = std::max(upper, pair.first);
+		}
+
+		base_type::band_matrix<T> matrix(n, lower, upper);
+		for (auto& pair : values)
+			matrix.fill_diagonal(pair.second, pair.first);
+		return matrix;
+	}
+
+	template<typename T>
+	base_type::band_matrix<T> multidiagonal(const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& diagonals)
+	{
+		int32_t lower = 0, upper = 0;
+		for (auto& pair : diagonals)
+		{
+			lower = std::max(lower, -pair.first);
+			upper = std::max(upper, pair.first);
+		}
+
+		auto n = diagonals.begin()->second.size() + std::abs(diagonals.begin()->first);
+		base_type::band_matrix<T> matrix(n, lower, upper);
+		for (auto& pair : diagonals)
+			matrix.fill_diagonal(pair.second, pair.first);
+		return matrix;
+	}
+
+	template<typename T>
+	inline base_type::band_lu_base<T> lu(const base_type::band_matrix<T>& matr)
+	{
+		return base_type::band_lu_base<T>(matr);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> solve(const base_type::band_matrix<T>& matr, const base_type::vector_base<T>& b)
+	{
+		return matr.solve(b);
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> solve(const base_type::band_matrix<T>& matr, const base_type::matrix_base<T>& b)
+	{
+		return matr.solve(b);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> thomas(
+		const base_type::vector_base<T>& lower,
+		const base_type::vector_base<T>& diag,
+		const base_type::vector_base<T>& upper,
+		const base_type::vector_base<T>& b)
+	{
+		auto n = diag.size();
+		assert(b.size() == n && lower.size() + 1 == n && upper.size() + 1 == n);
+
+		base_type::vector_base<T> x(b);
+		kernel::thomas(n, 1, lower.base.data(), diag.base.data(), upper.base.data(), x.base.data(), 1);
+		return x;
+	}
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::band_matrix<T>& matrix)
+{
+	auto [m, n] = matrix.size();
+	for (nm::uint128_t i = 0; i < m; i++)
+	{
+		for (nm::uint128_t j = 0; j < n; j++)
+			out << "\t" << matrix(i, j);
+		out << "\n";
+	}
+	out << typeid(matrix).name() << "\n";
+	return out;
+}
@@ -0,0 +1,639 @@
+#include "../include/batched.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		template<typename F>
+		struct batch_traits
+		{
+			static constexpr uint128_t size = 1;
+
+			static constexpr F& at(F& x, uint128_t) { return x; }
+			static constexpr const F& at(const F& x, uint128_t) { return x; }
+		};
+
+		template<typename T, uint128_t N>
+		struct batch_traits<base_type::fixed_vector<T, N>>
+		{
+			static constexpr uint128_t size = N;
+
+			static constexpr T& at(base_type::fixed_vector<T, N>& x, uint128_t k) { return x.base[k]; }
+			static constexpr const T& at(const base_type::fixed_vector<T, N>& x, uint128_t k) { return x.base[k]; }
+		};
+
+		template<typename T, uint128_t M, uint128_t N>
+		struct batch_traits<base_type::fixed_matrix<T, M, N>>
+		{
+			static constexpr uint128_t size = M * N;
+
+			static constexpr T& at(base_type::fixed_matrix<T, M, N>& x, uint128_t k) { return x.base[k]; }
+			static constexpr const T& at(const base_type::fixed_matrix<T, M, N>& x, uint128_t k) { return x.base[k]; }
+		};
+
+		template<typename F, typename T>
+		inline F batch_load(const T* p, uint128_t stride, uint128_t b)
+		{
+			F result;
+			for (uint128_t k = 0; k < batch_traits<F>::size; k++)
+				batch_traits<F>::at(result, k) = p[k * stride + b];
+			return result;
+		}
+
+		template<typename F, typename T>
+		inline void batch_store(const F& value, T* p, uint128_t stride, uint128_t b)
+		{
+			for (uint128_t k = 0; k < batch_traits<F>::size; k++)
+				p[k * stride + b] = batch_traits<F>::at(value, k);
+		}
+
+		template<typename F>
+		inline void batch_for(uint128_t count, uint128_t cost, F&& body)
+		{
+			// full tiles pass the member count as a constant type: the member
+			// loops of their kernels get a known trip count and no remainder
+			uint128_t tiles = (count + BATCH_TILE - 1) / BATCH_TILE;
+			parallel::parallel_for(0, tiles, count * cost, [&](uint128_t lo, uint128_t hi)
+			{
+				for (uint128_t t = lo; t < hi; t++)
+				{
+					uint128_t b0 = t * BATCH_TILE;
+					if (b0 + BATCH_TILE <= count)
+						body(b0, std::integral_constant<uint128_t, BATCH_TILE>());
+					else
+						body(b0, count - b0);
+				}
+			});
+		}
+
+		template<uint128_t N, typename T, typename W>
+		inline void batch_det(W w, uint128_t s, const T* __restrict a, T* __restrict r)
+		{
+			const uint128_t n = w;
+			NUMERIC_BATCH_LOOP
+			for (uint128_t b = 0; b < n; b++)
+			{
+				auto A = [&](uint128_t i, uint128_t j) { return a[(i * N + j) * s + b]; };
+				if constexpr (N == 1)
+					r[b] = A(0, 0);
+				else if constexpr (N == 2)
+					r[b] = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+				else if constexpr (N == 3)
+				{
+					r[b] =
+						  A(0, 0) * (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1))
+						- A(0, 1) * (A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0))
+						+ A(0, 2) * (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0));
+				}
+				else if constexpr (N == 4)
+				{
+					T s0 = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+					T s1 = A(0, 0) * A(1, 2) - A(0, 2) * A(1, 0);
+					T s2 = A(0, 0) * A(1, 3) - A(0, 3) * A(1, 0);
+					T s3 = A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1);
+					T s4 = A(0, 1) * A(1, 3) - A(0, 3) * A(1, 1);
+					T s5 = A(0, 2) * A(1, 3) - A(0, 3) * A(1, 2);
+					T c0 = A(2, 0) * A(3, 1) - A(2, 1) * A(3, 0);
+					T c1 = A(2, 0) * A(3, 2) - A(2, 2) * A(3, 0);
+					T c2 = A(2, 0) * A(3, 3) - A(2, 3) * A(3, 0);
+					T c3 = A(2, 1) * A(3, 2) - A(2, 2) * A(3, 1);
+					T c4 = A(2, 1) * A(3, 3) - A(2, 3) * A(3, 1);
+					T c5 = A(2, 2) * A(3, 3) - A(2, 3) * A(3, 2);
+					r[b] = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+				}
+				else
+					r[b] = batch_load<base_type::fixed_matrix<T, N, N>>(a, s, b).det();
+			}
+		}
+
+		template<uint128_t N, typename T, typename W>
+		inline void batch_inverse(W w, uint128_t s, const T* __restrict a, T* __restrict r)
+		{
+			const uint128_t n = w;
+			NUMERIC_BATCH_LOOP
+			for (uint128_t b = 0; b < n; b++)
+			{
+				auto A = [&](uint128_t i, uint128_t j) { return a[(i * N + j) * s + b]; };
+				auto R = [&](uint128_t i, uint128_t j) -> T& { return r[(i * N + j) * s + b]; };
+				if constexpr (N == 1)
+					R(0, 0) = T(1) / A(0, 0);
+				else if constexpr (N == 2)
+				{
+					T inv = T(1) / (A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0));
+					R(0, 0) = A(1, 1) * inv;
+					R(0, 1) = -A(0, 1) * inv;
+					R(1, 0) = -A(1, 0) * inv;
+					R(1, 1) = A(0, 0) * inv;
+				}
+				else if constexpr (N == 3)
+				{
+					T c00 = A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1);
+					T c01 = A(1, 2) * A(2, 0) - A(1, 0) * A(2, 2);
+					T c02 = A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0);
+					T inv = T(1) / (A(0, 0) * c00 + A(0, 1) * c01 + A(0, 2) * c02);
+					R(0, 0) = c00 * inv;
+					R(1, 0) = c01 * inv;
+					R(2, 0) = c02 * inv;
+					R(0, 1) = (A(0, 2) * A(2, 1) - A(0, 1) * A(2, 2)) * inv;
+					R(1, 1) = (A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0)) * inv;
+					R(2, 1) = (A(0, 1) * A(2, 0) - A(0, 0) * A(2, 1)) * inv;
+					R(0, 2) = (A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1)) * inv;
+					R(1, 2) = (A(0, 2) * A(1, 0) - A(0, 0) * A(1, 2)) * inv;
+					R(2, 2) = (A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0)) * inv;
+				}
+				else if constexpr (N == 4)
+				{
+					T s0 = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+					T s1 = A(0, 0) * A(1, 2) - A(0, 2) * A(1, 0);
+					T s2 = A(0, 0) * A(1, 3) - A(0, 3) * A(1, 0);
+					T s3 = A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1);
+					T s4 = A(0, 1) * A(1, 3) - A(0, 3) * A(1, 1);
+					T s5 = A(0, 2) * A(1, 3) - A(0, 3) * A(1, 2);
+					T c0 = A(2, 0) * A(3, 1) - A(2, 1) * A(3, 0);
+					T c1 = A(2, 0) * A(3, 2) - A(2, 2) * A(3, 0);
+					T c2 = A(2, 0) * A(3, 3) - A(2, 3) * A(3, 0);
+					T c3 = A(2, 1) * A(3, 2) - A(2, 2) * A(3, 1);
+					T c4 = A(2, 1) * A(3, 3) - A(2, 3) * A(3, 1);
+					T c5 = A(2, 2) * A(3, 3) - A(2, 3) * A(3, 2);
+					T inv = T(1) / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+					R(0, 0) = ( A(1, 1) * c5 - A(1, 2) * c4 + A(1, 3) * c3) * inv;
+					R(0, 1) = (-A(0, 1) * c5 + A(0, 2) * c4 - A(0, 3) * c3) * inv;
+					R(0, 2) = ( A(3, 1) * s5 - A(3, 2) * s4 + A(3, 3) * s3) * inv;
+					R(0, 3) = (-A(2, 1) * s5 + A(2, 2) * s4 - A(2, 3) * s3) * inv;
+					R(1, 0) = (-A(1, 0) * c5 + A(1, 2) * c2 - A(1, 3) * c1) * inv;
+					R(1, 1) = ( A(0, 0) * c5 - A(0, 2) * c2 + A(0, 3) * c1) * inv;
+					R(1, 2) = (-A(3, 0) * s5 + A(3, 2) * s2 - A(3, 3) * s1) * inv;
+					R(1, 3) = ( A(2, 0) * s5 - A(2, 2) * s2 + A(2, 3) * s1) * inv;
+					R(2, 0) = ( A(1, 0) * c4 - A(1, 1) * c2 + A(1, 3) * c0) * inv;
+					R(2, 1) = (-A(0, 0) * c4 + A(0, 1) * c2 - A(0, 3) * c0) * inv;
+					R(2, 2) = ( A(3, 0) * s4 - A(3, 1) * s2 + A(3, 3) * s0) * inv;
+					R(2, 3) = (-A(2, 0) * s4 + A(2, 1) * s2 - A(2, 3) * s0) * inv;
+					R(3, 0) = (-A(1, 0) * c3 + A(1, 1) * c1 - A(1, 2) * c0) * inv;
+					R(3, 1) = ( A(0, 0) * c3 - A(0, 1) * c1 + A(0, 2) * c0) * inv;
+					R(3, 2) = (-A(3, 0) * s3 + A(3, 1) * s1 - A(3, 2) * s0) * inv;
+					R(3, 3) = ( A(2, 0) * s3 - A(2, 1) * s1 + A(2, 2) * s0) * inv;
+				}
+				else
+					batch_store(batch_load<base_type::fixed_matrix<T, N, N>>(a, s, b).inversed(), r, s, b);
+			}
+		}
+
+		template<uint128_t N, typename T, typename W>
+		inline void batch_solve(W w, uint128_t s, const T* __restrict a, const T* __restrict f, T* __restrict x)
+		{
+			// x = adj(A) f / det(A), the inverse is never stored
+			const uint128_t n = w;
+			NUMERIC_BATCH_LOOP
+			for (uint128_t b = 0; b < n; b++)
+			{
+				auto A = [&](uint128_t i, uint128_t j) { return a[(i * N + j) * s + b]; };
+				auto F = [&](uint128_t i) { return f[i * s + b]; };
+				if constexpr (N == 1)
+					x[b] = F(0) / A(0, 0);
+				else if constexpr (N == 2)
+				{
+					T inv = T(1) / (A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0));
+					x[b] = (A(1, 1) * F(0) - A(0, 1) * F(1)) * inv;
+					x[s + b] = (A(0, 0) * F(1) - A(1, 0) * F(0)) * inv;
+				}
+				else if constexpr (N == 3)
+				{
+					T c00 = A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1);
+					T c01 = A(1, 2) * A(2, 0) - A(1, 0) * A(2, 2);
+					T c02 = A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0);
+					T inv = T(1) / (A(0, 0) * c00 + A(0, 1) * c01 + A(0, 2) * c02);
+					T f0 = F(0), f1 = F(1), f2 = F(2);
+					x[b] = (c00 * f0
+						+ (A(0, 2) * A(2, 1) - A(0, 1) * A(2, 2)) * f1
+						+ (A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1)) * f2) * inv;
+					x[s + b] = (c01 * f0
+						+ (A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0)) * f1
+						+ (A(0, 2) * A(1, 0) - A(0, 0) * A(1, 2)) * f2) * inv;
+					x[2 * s + b] = (c02 * f0
+						+ (A(0, 1) * A(2, 0) - A(0, 0) * A(2, 1)) * f1
+						+ (A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0)) * f2) * inv;
+				}
+				else if constexpr (N == 4)
+				{
+					T s0 = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+					T s1 = A(0, 0) * A(1, 2) - A(0, 2) * A(1, 0);
+					T s2 = A(0, 0) * A(1, 3) - A(0, 3) * A(1, 0);
+					T s3 = A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1);
+					T s4 = A(0, 1) * A(1, 3) - A(0, 3) * A(1, 1);
+					T s5 = A(0, 2) * A(1, 3) - A(0, 3) * A(1, 2);
+					T c0 = A(2, 0) * A(3, 1) - A(2, 1) * A(3, 0);
+					T c1 = A(2, 0) * A(3, 2) - A(2, 2) * A(3, 0);
+					T c2 = A(2, 0) * A(3, 3) - A(2, 3) * A(3, 0);
+					T c3 = A(2, 1) * A(3, 2) - A(2, 2) * A(3, 1);
+					T c4 = A(2, 1) * A(3, 3) - A(2, 3) * A(3, 1);
+					T c5 = A(2, 2) * A(3, 3) - A(2, 3) * A(3, 2);
+					T inv = T(1) / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+					T f0 = F(0), f1 = F(1), f2 = F(2), f3 = F(3);
+
+					x[b] = (( A(1, 1) * c5 - A(1, 2) * c4 + A(1, 3) * c3) * f0
+						+ (-A(0, 1) * c5 + A(0, 2) * c4 - A(0, 3) * c3) * f1
+						+ ( A(3, 1) * s5 - A(3, 2) * s4 + A(3, 3) * s3) * f2
+						+ (-A(2, 1) * s5 + A(2, 2) * s4 - A(2, 3) * s3) * f3) * inv;
+					x[s + b] = ((-A(1, 0) * c5 + A(1, 2) * c2 - A(1, 3) * c1) * f0
+						+ ( A(0, 0) * c5 - A(0, 2) * c2 + A(0, 3) * c1) * f1
+						+ (-A(3, 0) * s5 + A(3, 2) * s2 - A(3, 3) * s1) * f2
+						+ ( A(2, 0) * s5 - A(2, 2) * s2 + A(2, 3) * s1) * f3) * inv;
+					x[2 * s + b] = (( A(1, 0) * c4 - A(1, 1) * c2 + A(1, 3) * c0) * f0
+						+ (-A(0, 0) * c4 + A(0, 1) * c2 - A(0, 3) * c0) * f1
+						+ ( A(3, 0) * s4 - A(3, 1) * s2 + A(3, 3) * s0) * f2
+						+ (-A(2, 0) * s4 + A(2, 1) * s2 - A(2, 3) * s0) * f3) * inv;
+					x[3 * s + b] = ((-A(1, 0) * c3 + A(1, 1) * c1 - A(1, 2) * c0) * f0
+						+ ( A(0, 0) * c3 - A(0, 1) * c1 + A(0, 2) * c0) * f1
+						+ (-A(3, 0) * s3 + A(3, 1) * s1 - A(3, 2) * s0) * f2
+						+ ( A(2, 0) * s3 - A(2, 1) * s1 + A(2, 2) * s0) * f3) * inv;
+				}
+				else
+				{
+					auto m = batch_load<base_type::fixed_matrix<T, N, N>>(a, s, b);
+					auto v = batch_load<base_type::fixed_vector<T, N>>(f, s, b);
+					batch_store(m.inversed() * v, x, s, b);
+				}
+			}
+		}
+
+		template<typename T, typename W>
+		inline void batch_cross(W w, uint128_t s, const T* __restrict u, const T* __restrict v, T* __restrict r)
+		{
+			const uint128_t n = w;
+			NUMERIC_BATCH_LOOP
+			for (uint128_t b = 0; b < n; b++)
+			{
+				T u0 = u[b], u1 = u[s + b], u2 = u[2 * s + b];
+				T v0 = v[b], v1 = v[s + b], v2 = v[2 * s + b];
+				r[b] = u1 * v2 - u2 * v1;
+				r[s + b] = u2 * v0 - u0 * v2;
+				r[2 * s + b] = u0 * v1 - u1 * v0;
+			}
+		}
+
+		template<uint128_t M, uint128_t N, uint128_t K, typename T, typename W>
+		inline void batch_gemm(W w, uint128_t s, const T* __restrict a, const T* __restrict x, T* __restrict r)
+		{
+			// r_ij = sum a_ik * x_kj, the sum stays in a register
+			const uint128_t n = w;
+			for (uint128_t i = 0; i < M; i++)
+				for (uint128_t j = 0; j < K; j++)
+					NUMERIC_BATCH_LOOP
+					for (uint128_t b = 0; b < n; b++)
+					{
+						T acc = 0;
+						for (uint128_t k = 0; k < N; k++)
+							acc += a[(i * N + k) * s + b] * x[(k * K + j) * s + b];
+						r[(i * K + j) * s + b] = acc;
+					}
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>::batch_vector(uint128_t count) :
+			count(count),
+			base(N * count, T(0))
+		{
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>::batch_vector(uint128_t count, const value_type& value) :
+			count(count),
+			base(N * count)
+		{
+			for (uint128_t i = 0; i < N; i++)
+				std::fill_n(plane(i), count, value[i]);
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>::batch_vector(const std::vector<value_type>& vects) :
+			count(vects.size()),
+			base(N * vects.size())
+		{
+			for (uint128_t b = 0; b < count; b++)
+				kernel::batch_store(vects[b], base.data(), count, b);
+		}
+
+		template<typename T, uint128_t N>
+		inline uint128_t batch_vector<T, N>::size() const
+		{
+			return count;
+		}
+
+		template<typename T, uint128_t N>
+		inline typename batch_vector<T, N>::value_type batch_vector<T, N>::operator [](uint128_t b) const
+		{
+			return kernel::batch_load<value_type>(base.data(), count, b);
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>& batch_vector<T, N>::set(uint128_t b, const value_type& value)
+		{
+			kernel::batch_store(value, base.data(), count, b);
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		inline std::vector<typename batch_vector<T, N>::value_type> batch_vector<T, N>::unpacked() const
+		{
+			std::vector<value_type> result(count);
+			for (uint128_t b = 0; b < count; b++)
+				result[b] = (*this)[b];
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		inline T* batch_vector<T, N>::plane(uint128_t i)
+		{
+			return base.data() + i * count;
+		}
+
+		template<typename T, uint128_t N>
+		inline const T* batch_vector<T, N>::plane(uint128_t i) const
+		{
+			return base.data() + i * count;
+		}
+
+		template<typename T, uint128_t N>
+		inline vector_base<T> batch_vector<T, N>::dot(const batch_vector& oth) const
+		{
+			// plane by plane, the members are the inner loop
+			assert(count == oth.count);
+			vector_base<T> result(count);
+			T* r = result.base.data();
+			for (uint128_t i = 0; i < N; i++)
+			{
+				const T* x = plane(i);
+				const T* y = oth.plane(i);
+				for (uint128_t b = 0; b < count; b++)
+					r[b] += x[b] * y[b];
+			}
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N> batch_vector<T, N>::cross(const batch_vector& oth) const
+		{
+			static_assert(N == 3, "cross product is defined for 3-vectors only!");
+			assert(count == oth.count);
+			batch_vector result(count);
+			kernel::batch_for(count, 9, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_cross(w, count, base.data() + b0, oth.base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		inline vector_base<T> batch_vector<T, N>::norm2() const
+		{
+			vector_base<T> result(count);
+			T* r = result.base.data();
+			for (uint128_t i = 0; i < N; i++)
+			{
+				const T* x = plane(i);
+				for (uint128_t b = 0; b < count; b++)
+					r[b] += x[b] * nm::conj(x[b]);
+			}
+			for (uint128_t b = 0; b < count; b++)
+				r[b] = std::sqrt(r[b]);
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>& batch_vector<T, N>::operator +=(const batch_vector& oth)
+		{
+			assert(count == oth.count);
+			for (uint128_t k = 0; k < base.size(); k++)
+				base[k] += oth.base[k];
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>& batch_vector<T, N>::operator -=(const batch_vector& oth)
+		{
+			assert(count == oth.count);
+			for (uint128_t k = 0; k < base.size(); k++)
+				base[k] -= oth.base[k];
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N>& batch_vector<T, N>::operator *=(const T& value)
+		{
+			for (auto& x : base)
+				x *= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N> batch_vector<T, N>::operator +(const batch_vector& oth) const
+		{
+			batch_vector result(*this);
+			return result += oth;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N> batch_vector<T, N>::operator -(const batch_vector& oth) const
+		{
+			batch_vector result(*this);
+			return result -= oth;
+		}
+
+		template<typename T, uint128_t N>
+		inline batch_vector<T, N> batch_vector<T, N>::operator *(const T& value) const
+		{
+			batch_vector result(*this);
+			return result *= value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>::batch_matrix(uint128_t count) :
+			count(count),
+			base(M * N * count, T(0))
+		{
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>::batch_matrix(uint128_t count, const value_type& value) :
+			count(count),
+			base(M * N * count)
+		{
+			for (uint128_t k = 0; k < M * N; k++)
+				std::fill_n(base.data() + k * count, count, value.base[k]);
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>::batch_matrix(const std::vector<value_type>& matrs) :
+			count(matrs.size()),
+			base(M * N * matrs.size())
+		{
+			for (uint128_t b = 0; b < count; b++)
+				kernel::batch_store(matrs[b], base.data(), count, b);
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline uint128_t batch_matrix<T, M, N>::size() const
+		{
+			return count;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline typename batch_matrix<T, M, N>::value_type batch_matrix<T, M, N>::operator [](uint128_t b) const
+		{
+			return kernel::batch_load<value_type>(base.data(), count, b);
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>& batch_matrix<T, M, N>::set(uint128_t b, const value_type& value)
+		{
+			kernel::batch_store(value, base.data(), count, b);
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline std::vector<typename batch_matrix<T, M, N>::value_type> batch_matrix<T, M, N>::unpacked() const
+		{
+			std::vector<value_type> result(count);
+			for (uint128_t b = 0; b < count; b++)
+				result[b] = (*this)[b];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline T* batch_matrix<T, M, N>::plane(uint128_t i, uint128_t j)
+		{
+			return base.data() + (i * N + j) * count;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline const T* batch_matrix<T, M, N>::plane(uint128_t i, uint128_t j) const
+		{
+			return base.data() + (i * N + j) * count;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, N, M> batch_matrix<T, M, N>::transposed() const
+		{
+			// whole planes move, members stay in place
+			batch_matrix<T, N, M> result(count);
+			for (uint128_t i = 0; i < M; i++)
+				for (uint128_t j = 0; j < N; j++)
+					std::copy_n(plane(i, j), count, result.plane(j, i));
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline vector_base<T> batch_matrix<T, M, N>::det() const
+		{
+			static_assert(M == N, "determinant is defined for square matrices only!");
+			vector_base<T> result(count);
+			kernel::batch_for(count, N * N * N, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_det<N>(w, count, base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N> batch_matrix<T, M, N>::inversed() const
+		{
+			static_assert(M == N, "inverse is defined for square matrices only!");
+			batch_matrix result(count);
+			kernel::batch_for(count, 2 * N * N * N, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_inverse<N>(w, count, base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_vector<T, M> batch_matrix<T, M, N>::solve(const batch_vector<T, M>& rhs) const
+		{
+			static_assert(M == N, "solve is defined for square matrices only!");
+			assert(count == rhs.count);
+			batch_vector<T, M> result(count);
+			kernel::batch_for(count, 2 * N * N * N, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_solve<N>(w, count, base.data() + b0, rhs.base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>& batch_matrix<T, M, N>::operator +=(const batch_matrix& oth)
+		{
+			assert(count == oth.count);
+			for (uint128_t k = 0; k < base.size(); k++)
+				base[k] += oth.base[k];
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>& batch_matrix<T, M, N>::operator -=(const batch_matrix& oth)
+		{
+			assert(count == oth.count);
+			for (uint128_t k = 0; k < base.size(); k++)
+				base[k] -= oth.base[k];
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N>& batch_matrix<T, M, N>::operator *=(const T& value)
+		{
+			for (auto& x : base)
+				x *= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N> batch_matrix<T, M, N>::operator +(const batch_matrix& oth) const
+		{
+			batch_matrix result(*this);
+			return result += oth;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N> batch_matrix<T, M, N>::operator -(const batch_matrix& oth) const
+		{
+			batch_matrix result(*this);
+			return result -= oth;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_matrix<T, M, N> batch_matrix<T, M, N>::operator *(const T& value) const
+		{
+			batch_matrix result(*this);
+			return result *= value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		template<uint128_t K>
+		inline batch_matrix<T, M, K> batch_matrix<T, M, N>::operator *(const batch_matrix<T, N, K>& oth) const
+		{
+			assert(count == oth.count);
+			batch_matrix<T, M, K> result(count);
+			kernel::batch_for(count, 2 * M * N * K, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_gemm<M, N, K>(w, count, base.data() + b0, oth.base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline batch_vector<T, M> batch_matrix<T, M, N>::operator *(const batch_vector<T, N>& vect) const
+		{
+			// a vector is a batch of N x 1 matrices
+			assert(count == vect.count);
+			batch_vector<T, M> result(count);
+			kernel::batch_for(count, 2 * M * N, [&](uint128_t b0, auto w)
+			{
+				kernel::batch_gemm<M, N, 1>(w, count, base.data() + b0, vect.base.data() + b0, result.base.data() + b0);
+			});
+			return result;
+		}
+	}
+}
@@ -48,6 +48,30 @@ namespace nm
 	{
 		return value.abs();
 	}
+
+	template<typename T>
+	inline base_type::complex_base<T> conj(const base_type::complex_base<T>& value)
+	{
+		return value.conjugate();
+	}
+
+	template<typename T>
+	inline T real(const base_type::complex_base<T>& value)
+	{
+		return value.real;
+	}
+
+	template<typename T, typename>
+	inline T conj(const T& value)
+	{
+		return value;
+	}
+
+	template<typename T, typename>
+	inline T real(const T& value)
+	{
+		return value;
+	}
 }
 
 template <typename T>
@@ -263,39 +287,45 @@ inline bool nm::base_type::complex_base<T>::operator!=(const V& value) const
 	return abs() != value;
 }
 
-template<typename T, typename V>
-inline auto operator+(const V& value, const nm::base_type::complex_base<T>& c)
+namespace nm
 {
-	return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
-		value + c.real,
-		c.imag
-	);
-}
+	namespace base_type
+	{
+		template<typename T, typename V, typename>
+		inline auto operator+(const V& value, const nm::base_type::complex_base<T>& c)
+		{
+			return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
+				value + c.real,
+				c.imag
+			);
+		}
 
-template <typename T, typename V>
-inline auto operator -(const V& value, const nm::base_type::complex_base<T>& c)
-{
-	return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
-		value - c.real,
-		-c.imag
-	);
-}
+		template <typename T, typename V, typename>
+		inline auto operator -(const V& value, const nm::base_type::complex_base<T>& c)
+		{
+			return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
+				value - c.real,
+				-c.imag
+			);
+		}
 
-template <typename T, typename V>
-inline auto operator *(const V& value, const nm::base_type::complex_base<T>& c)
-{
-	return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
-		c.real * value,
-		c.imag * value
-	);
-}
+		template <typename T, typename V, typename>
+		inline auto operator *(const V& value, const nm::base_type::complex_base<T>& c)
+		{
+			return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
+				c.real * value,
+				c.imag * value
+			);
+		}
 
-template <typename T, typename V>
-inline auto operator /(const V& value, const nm::base_type::complex_base<T>& c)
-{
-	auto inv = c.inverse();
-	return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
-		inv.real * value,
-		inv.imag * value
-	);
-}
+		template <typename T, typename V, typename>
+		inline auto operator /(const V& value, const nm::base_type::complex_base<T>& c)
+		{
+			auto inv = c.inversed();
+			return nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, nm::base_type::complex_base<T>, nm::base_type::complex_base<V>>(
+				inv.real * value,
+				inv.imag * value
+			);
+		}
+	}
+}
\ No newline at end of file
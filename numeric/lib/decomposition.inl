@@ -0,0 +1,885 @@
+#include "../include/decomposition.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// blocked A = L L^H (ldl = false) or A = L D L^H (ldl = true) on the lower triangle,
+		// D is stored on the diagonal, strictly upper triangle is not referenced
+		template<typename T>
+		inline bool hermitian_factor(bool ldl, uint128_t n, T* a, uint128_t ld)
+		{
+			using R = typing::real_type_t<T>;
+			std::vector<T> w(LU_BLOCK_SIZE);
+
+			for (uint128_t kb = 0; kb < n; kb += LU_BLOCK_SIZE)
+			{
+				auto ke = std::min(kb + LU_BLOCK_SIZE, n);
+
+				// panel [kb, n) x [kb, ke), sums run over the panel columns only,
+				// earlier panels are already subtracted by the trailing update
+				for (uint128_t j = kb; j < ke; j++)
+				{
+					const T* rowj = a + j * ld + kb;
+					auto len = j - kb;
+					for (uint128_t r = 0; r < len; r++)
+						w[r] = ldl ? a[(kb + r) * ld + kb + r] * nm::conj(rowj[r]) : nm::conj(rowj[r]);
+
+					R d = nm::real(a[j * ld + j] - row_dot(len, rowj, w.data()));
+					if (ldl ? d == 0 : !(d > 0))
+						return false;
+
+					T pivot = ldl ? T(d) : T(std::sqrt(d));
+					T inverse = T(1) / pivot;
+					a[j * ld + j] = pivot;
+					for (uint128_t i = j + 1; i < n; i++)
+					{
+						T* rowi = a + i * ld;
+						rowi[j] = (rowi[j] - row_dot(len, rowi + kb, w.data())) * inverse;
+					}
+				}
+
+				if (ke == n)
+					break;
+
+				// A22 -= L21 * W, W = D1 * L21^H is nb x m; every block row is updated
+				// left of its diagonal block by gemm and inside it on the lower triangle only
+				auto nb = ke - kb;
+				auto m = n - ke;
+				std::vector<T> wt(nb * m);
+				for (uint128_t i = 0; i < m; i++)
+					for (uint128_t c = 0; c < nb; c++)
+						wt[c * m + i] = (ldl ? a[(kb + c) * ld + kb + c] : T(1)) * nm::conj(a[(ke + i) * ld + kb + c]);
+
+				auto nblocks = (m + LU_BLOCK_SIZE - 1) / LU_BLOCK_SIZE;
+				parallel::parallel_for(0, nblocks, m * m * nb / 2, [&](uint128_t lo, uint128_t hi)
+				{
+					for (auto blk = lo; blk < hi; blk++)
+					{
+						auto ib = ke + blk * LU_BLOCK_SIZE;
+						auto ie = std::min(ib + LU_BLOCK_SIZE, n);
+						gemm<T>(ie - ib, ib - ke, nb, T(-1), a + ib * ld + kb, ld, wt.data(), m, T(1), a + ib * ld + ke, ld);
+
+						for (uint128_t i = ib; i < ie; i++)
+						{
+							const T* li = a + i * ld + kb;
+							for (uint128_t j = ib; j <= i; j++)
+							{
+								T sum = 0;
+								for (uint128_t c = 0; c < nb; c++)
+									sum += li[c] * wt[c * m + j - ke];
+								a[i * ld + j] -= sum;
+							}
+						}
+					}
+				});
+			}
+			return true;
+		}
+
+		// upper triangle = conjugate transpose of the strictly lower one
+		template<typename T>
+		inline void hermitian_mirror(uint128_t n, T* a, uint128_t ld)
+		{
+			for (uint128_t i = 0; i < n; i++)
+				for (uint128_t j = i + 1; j < n; j++)
+					a[i * ld + j] = nm::conj(a[j * ld + i]);
+		}
+
+		// sum of body(i, acc) over rows [beg, end), every thread fills its own copy of acc;
+		// partial sums are added in row order, so the result does not depend on timing
+		template<typename T, typename F>
+		inline memory::vector<T> reduce_rows(uint128_t beg, uint128_t end, uint128_t size, uint128_t work, F&& body)
+		{
+			std::vector<std::pair<uint128_t, std::vector<T>>> partial;
+			std::mutex guard;
+			parallel::parallel_for(beg, end, work, [&](uint128_t lo, uint128_t hi)
+			{
+				std::vector<T> acc(size, T(0));
+				for (auto i = lo; i < hi; i++)
+					body(i, acc.data());
+
+				std::lock_guard<std::mutex> lock(guard);
+				partial.emplace_back(lo, std::move(acc));
+			});
+
+			std::sort(partial.begin(), partial.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+			memory::vector<T> total(size, T(0));
+			for (auto& [lo, acc] : partial)
+				for (uint128_t c = 0; c < size; c++)
+					total[c] += acc[c];
+			return total;
+		}
+
+		// unblocked QR of the panel [k, m) x [k, ke): reflector H_j zeroes column j
+		// below the diagonal, H_j^H is applied to the panel columns right of j
+		template<typename T>
+		inline void householder_panel(uint128_t m, uint128_t k, uint128_t ke, T* a, uint128_t ld, T* tau)
+		{
+			using R = typing::real_type_t<T>;
+			for (uint128_t j = k; j < ke; j++)
+			{
+				auto rest = ke - j - 1;
+
+				// one pass over the rows: [0] = |x|^2, [1 + c] = x^H a_c
+				auto sums = reduce_rows<T>(j + 1, m, rest + 1, (m - j) * (rest + 1), [&](uint128_t i, T* acc)
+				{
+					const T* row = a + i * ld + j;
+					T xi = nm::conj(row[0]);
+					for (uint128_t c = 0; c <= rest; c++)
+						acc[c] += xi * row[c];
+				});
+
+				T alpha = a[j * ld + j];
+				R xnorm2 = nm::real(sums[0]);
+				R alpha_re = nm::real(alpha);
+				if (xnorm2 == 0 && alpha == T(alpha_re))
+				{
+					tau[j] = 0;
+					continue;
+				}
+
+				R beta = std::sqrt(nm::real(alpha * nm::conj(alpha)) + xnorm2);
+				if (alpha_re >= 0)
+					beta = -beta;
+
+				T t = (T(beta) - alpha) / T(beta);
+				T scale = T(1) / (alpha - T(beta));
+				T ct = nm::conj(t);
+				tau[j] = t;
+				a[j * ld + j] = beta;
+
+				// v = x * scale, w_c = a_jc + v^H a_c
+				std::vector<T> w(rest);
+				for (uint128_t c = 0; c < rest; c++)
+				{
+					w[c] = a[j * ld + j + 1 + c] + nm::conj(scale) * sums[c + 1];
+					a[j * ld + j + 1 + c] -= ct * w[c];
+				}
+
+				parallel::parallel_for(j + 1, m, (m - j) * (rest + 1), [&](uint128_t lo, uint128_t hi)
+				{
+					for (auto i = lo; i < hi; i++)
+					{
+						T* row = a + i * ld + j;
+						row[0] *= scale;
+						row_axpy(rest, -ct * row[0], w.data(), row + 1);
+					}
+				});
+			}
+		}
+
+		// B = (I - V T V^H) B (adjoint = false) or B = (I - V T V^H)^H B, where I - V T V^H = H_k ... H_{ke-1}
+		// are the reflectors [k, ke) stored in a; only rows [k, m) of B (m x nc) change
+		template<typename T>
+		inline void householder_block(bool adjoint, uint128_t m, uint128_t k, uint128_t ke, const T* a, uint128_t ld, const T* tau,
+			T* b, uint128_t ldb, uint128_t nc)
+		{
+			auto nb = ke - k;
+
+			// row i of V: zero above the diagonal, unit on it, stored reflector below
+			auto vrow = [&](uint128_t i, T* v)
+			{
+				for (uint128_t p = 0; p < nb; p++)
+				{
+					auto col = k + p;
+					v[p] = i < col ? T(0) : (i == col ? T(1) : a[i * ld + col]);
+				}
+			};
+
+			// one pass over the rows: G = V^H V (nb x nb) and W = V^H B (nb x nc)
+			auto sums = reduce_rows<T>(k, m, nb * (nb + nc), (m - k) * nb * (nb + nc), [&](uint128_t i, T* acc)
+			{
+				T v[QR_BLOCK_SIZE];
+				vrow(i, v);
+				const T* row = b + i * ldb;
+				for (uint128_t p = 0; p < nb; p++)
+				{
+					T cv = nm::conj(v[p]);
+					row_axpy(nb, cv, v, acc + p * nb);
+					row_axpy(nc, cv, row, acc + nb * nb + p * nc);
+				}
+			});
+			const T* g = sums.data();
+			const T* w = sums.data() + nb * nb;
+
+			// H_k ... H_{ke-1} = I - V T V^H, T is upper triangular
+			std::vector<T> tm(nb * nb, T(0));
+			for (uint128_t j = 0; j < nb; j++)
+			{
+				tm[j * nb + j] = tau[k + j];
+				for (uint128_t p = 0; p < j; p++)
+				{
+					T sum = 0;
+					for (uint128_t q = p; q < j; q++)
+						sum += tm[p * nb + q] * g[q * nb + j];
+					tm[p * nb + j] = -tau[k + j] * sum;
+				}
+			}
+
+			// W = T^H W or W = T W
+			std::vector<T> wt(nb * nc, T(0));
+			for (uint128_t p = 0; p < nb; p++)
+			{
+				if (adjoint)
+				{
+					for (uint128_t q = 0; q <= p; q++)
+						row_axpy(nc, nm::conj(tm[q * nb + p]), w + q * nc, wt.data() + p * nc);
+				}
+				else
+				{
+					for (uint128_t q = p; q < nb; q++)
+						row_axpy(nc, tm[p * nb + q], w + q * nc, wt.data() + p * nc);
+				}
+			}
+
+			// B -= V W, rows below the panel are a plain product
+			T v[QR_BLOCK_SIZE];
+			for (uint128_t i = k; i < std::min(ke, m); i++)
+			{
+				vrow(i, v);
+				for (uint128_t p = 0; p < nb; p++)
+					row_axpy(nc, -v[p], wt.data() + p * nc, b + i * ldb);
+			}
+			if (ke < m)
+				gemm<T>(m - ke, nc, nb, T(-1), a + ke * ld + k, ld, wt.data(), nc, T(1), b + ke * ldb, ldb);
+		}
+
+		// A2 = (I - V T V^H)^H A2 for the reflectors of panel [k, ke), A2 = [k, m) x [ke, n)
+		template<typename T>
+		inline void householder_update(uint128_t m, uint128_t n, uint128_t k, uint128_t ke, T* a, uint128_t ld, const T* tau)
+		{
+			householder_block(true, m, k, ke, a, ld, tau, a + ke, ld, n - ke);
+		}
+
+		// B = Q B (adjoint = false) or B = Q^H B, Q = H_0 H_1 ... H_{r-1}, B is m x k
+		template<typename T>
+		inline void householder_apply(bool adjoint, uint128_t m, uint128_t r, const T* a, uint128_t ld, const T* tau,
+			T* b, uint128_t ldb, uint128_t k)
+		{
+			// many columns: QR_BLOCK_SIZE reflectors at once, most of the work is in gemm
+			if (k >= QR_BLOCK_SIZE)
+			{
+				auto blocks = (r + QR_BLOCK_SIZE - 1) / QR_BLOCK_SIZE;
+				for (uint128_t s = 0; s < blocks; s++)
+				{
+					auto kb = (adjoint ? s : blocks - 1 - s) * QR_BLOCK_SIZE;
+					householder_block(adjoint, m, kb, std::min(kb + QR_BLOCK_SIZE, r), a, ld, tau, b, ldb, k);
+				}
+				return;
+			}
+
+			for (uint128_t s = 0; s < r; s++)
+			{
+				auto j = adjoint ? s : r - 1 - s;
+				T t = adjoint ? nm::conj(tau[j]) : tau[j];
+				if (t == T(0))
+					continue;
+
+				auto w = reduce_rows<T>(j + 1, m, k, (m - j) * k, [&](uint128_t i, T* acc)
+				{
+					row_axpy(k, nm::conj(a[i * ld + j]), b + i * ldb, acc);
+				});
+				for (uint128_t c = 0; c < k; c++)
+				{
+					w[c] += b[j * ldb + c];
+					b[j * ldb + c] -= t * w[c];
+				}
+
+				parallel::parallel_for(j + 1, m, (m - j) * k, [&](uint128_t lo, uint128_t hi)
+				{
+					for (auto i = lo; i < hi; i++)
+						row_axpy(k, -t * a[i * ld + j], w.data(), b + i * ldb);
+				});
+			}
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline lu_base<T>::lu_base(const matrix_base<T>& matr) :
+			lu(matr),
+			perm(matr.rows()),
+			sign(1),
+			singular(false)
+		{
+			assert(matr.is_square());
+			auto n = lu.rows();
+			auto ld = lu.ld;
+			T* a = lu.data();
+
+			for (uint128_t i = 0; i < n; i++)
+				perm[i] = i;
+
+			for (uint128_t kb = 0; kb < n; kb += LU_BLOCK_SIZE)
+			{
+				auto ke = std::min(kb + LU_BLOCK_SIZE, n);
+
+				// panel [kb, n) x [kb, ke) is factorized column by column,
+				// whole rows are swapped, so L columns on the left are permuted too
+				for (uint128_t j = kb; j < ke; j++)
+				{
+					auto p = j;
+					auto pmax = nm::abs(a[j * ld + j]);
+					for (uint128_t i = j + 1; i < n; i++)
+					{
+						auto value = nm::abs(a[i * ld + j]);
+						if (value > pmax)
+						{
+							p = i;
+							pmax = value;
+						}
+					}
+
+					if (p != j)
+					{
+						std::swap_ranges(a + j * ld, a + j * ld + n, a + p * ld);
+						std::swap(perm[j], perm[p]);
+						sign = -sign;
+					}
+
+					if (pmax == 0)
+					{
+						singular = true;
+						continue;
+					}
+
+					T pivot = T(1) / a[j * ld + j];
+					for (uint128_t i = j + 1; i < n; i++)
+					{
+						T* row = a + i * ld;
+						row[j] *= pivot;
+						kernel::row_axpy(ke - j - 1, -row[j], a + j * ld + j + 1, row + j + 1);
+					}
+				}
+
+				if (ke == n)
+					break;
+
+				// U12 = L11^-1 * A12
+				kernel::trsm(true, true, ke - kb, n - ke, a + kb * ld + kb, ld, a + kb * ld + ke, ld);
+
+				// A22 -= L21 * U12
+				kernel::gemm<T>(n - ke, n - ke, ke - kb, T(-1), a + ke * ld + kb, ld, a + kb * ld + ke, ld, T(1), a + ke * ld + ke, ld);
+			}
+		}
+
+		template<typename T>
+		inline uint128_t lu_base<T>::size() const
+		{
+			return lu.rows();
+		}
+
+		template<typename T>
+		inline bool lu_base<T>::is_singular() const
+		{
+			return singular;
+		}
+
+		template<typename T>
+		inline matrix_base<T> lu_base<T>::lower() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+			{
+				for (uint128_t j = 0; j < i; j++)
+					result(i, j) = lu(i, j);
+				result(i, i) = 1;
+			}
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> lu_base<T>::upper() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+				for (uint128_t j = i; j < n; j++)
+					result(i, j) = lu(i, j);
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> lu_base<T>::permutation() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+				result(i, perm[i]) = 1;
+			return result;
+		}
+
+		template<typename T>
+		inline T lu_base<T>::det() const
+		{
+			if (singular)
+				return 0;
+
+			T result = sign;
+			for (uint128_t i = 0; i < size(); i++)
+				result *= lu(i, i);
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> lu_base<T>::inverse() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			result.fill_diagonal(T(1));
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T> lu_base<T>::solve(const vector_base<T>& b) const
+		{
+			vector_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline matrix_base<T> lu_base<T>::solve(const matrix_base<T>& b) const
+		{
+			matrix_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T>& lu_base<T>::solve_inplace(vector_base<T>& b) const
+		{
+			auto n = size();
+			auto ld = lu.ld;
+			const T* a = lu.data();
+			assert(!singular && b.size() == n);
+
+			vector_base<T> x(n);
+			for (uint128_t i = 0; i < n; i++)
+				x.base[i] = b.base[perm[i]];
+
+			kernel::trsv(true, true, n, a, ld, x.base.data());
+			kernel::trsv(false, false, n, a, ld, x.base.data());
+
+			b.base = std::move(x.base);
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& lu_base<T>::solve_inplace(matrix_base<T>& b) const
+		{
+			auto n = size();
+			auto k = b.cols();
+			auto ld = lu.ld;
+			const T* a = lu.data();
+			assert(!singular && b.rows() == n);
+
+			matrix_base<T> x(n, k);
+			auto xld = x.ld;
+			for (uint128_t i = 0; i < n; i++)
+				std::copy_n(b.data() + perm[i] * b.ld, k, x.data() + i * xld);
+
+			kernel::trsm(true, true, n, k, a, ld, x.data(), xld);
+			kernel::trsm(false, false, n, k, a, ld, x.data(), xld);
+
+			b = std::move(x);
+			return b;
+		}
+
+		template<typename T>
+		inline cholesky_base<T>::cholesky_base(const matrix_base<T>& matr) :
+			factor(matr)
+		{
+			assert(matr.is_square());
+			positive = kernel::hermitian_factor(false, factor.rows(), factor.data(), factor.ld);
+			if (positive)
+				kernel::hermitian_mirror(factor.rows(), factor.data(), factor.ld);
+		}
+
+		template<typename T>
+		inline uint128_t cholesky_base<T>::size() const
+		{
+			return factor.rows();
+		}
+
+		template<typename T>
+		inline bool cholesky_base<T>::is_positive() const
+		{
+			return positive;
+		}
+
+		template<typename T>
+		inline matrix_base<T> cholesky_base<T>::lower() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+				for (uint128_t j = 0; j <= i; j++)
+					result(i, j) = factor(i, j);
+			return result;
+		}
+
+		template<typename T>
+		inline T cholesky_base<T>::det() const
+		{
+			if (!positive)
+				return 0;
+
+			T result = 1;
+			for (uint128_t i = 0; i < size(); i++)
+				result *= factor(i, i) * factor(i, i);
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> cholesky_base<T>::inverse() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			result.fill_diagonal(T(1));
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T> cholesky_base<T>::solve(const vector_base<T>& b) const
+		{
+			vector_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline matrix_base<T> cholesky_base<T>::solve(const matrix_base<T>& b) const
+		{
+			matrix_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T>& cholesky_base<T>::solve_inplace(vector_base<T>& b) const
+		{
+			auto n = size();
+			assert(positive && b.size() == n);
+			kernel::trsv(true, false, n, factor.data(), factor.ld, b.base.data());
+			kernel::trsv(false, false, n, factor.data(), factor.ld, b.base.data());
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& cholesky_base<T>::solve_inplace(matrix_base<T>& b) const
+		{
+			auto n = size();
+			assert(positive && b.rows() == n);
+			kernel::trsm(true, false, n, b.cols(), factor.data(), factor.ld, b.data(), b.ld);
+			kernel::trsm(false, false, n, b.cols(), factor.data(), factor.ld, b.data(), b.ld);
+			return b;
+		}
+
+		template<typename T>
+		inline ldlt_base<T>::ldlt_base(const matrix_base<T>& matr) :
+			factor(matr)
+		{
+			assert(matr.is_square());
+			singular = !kernel::hermitian_factor(true, factor.rows(), factor.data(), factor.ld);
+			if (!singular)
+				kernel::hermitian_mirror(factor.rows(), factor.data(), factor.ld);
+		}
+
+		template<typename T>
+		inline uint128_t ldlt_base<T>::size() const
+		{
+			return factor.rows();
+		}
+
+		template<typename T>
+		inline bool ldlt_base<T>::is_singular() const
+		{
+			return singular;
+		}
+
+		template<typename T>
+		inline matrix_base<T> ldlt_base<T>::lower() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+			{
+				for (uint128_t j = 0; j < i; j++)
+					result(i, j) = factor(i, j);
+				result(i, i) = 1;
+			}
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T> ldlt_base<T>::diagonal() const
+		{
+			return factor.diagonal();
+		}
+
+		template<typename T>
+		inline T ldlt_base<T>::det() const
+		{
+			if (singular)
+				return 0;
+
+			T result = 1;
+			for (uint128_t i = 0; i < size(); i++)
+				result *= factor(i, i);
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> ldlt_base<T>::inverse() const
+		{
+			auto n = size();
+			matrix_base<T> result(n, n);
+			result.fill_diagonal(T(1));
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T> ldlt_base<T>::solve(const vector_base<T>& b) const
+		{
+			vector_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline matrix_base<T> ldlt_base<T>::solve(const matrix_base<T>& b) const
+		{
+			matrix_base<T> result(b);
+			return solve_inplace(result);
+		}
+
+		template<typename T>
+		inline vector_base<T>& ldlt_base<T>::solve_inplace(vector_base<T>& b) const
+		{
+			auto n = size();
+			assert(!singular && b.size() == n);
+			kernel::trsv(true, true, n, factor.data(), factor.ld, b.base.data());
+			for (uint128_t i = 0; i < n; i++)
+				b.base[i] /= factor(i, i);
+			kernel::trsv(false, true, n, factor.data(), factor.ld, b.base.data());
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& ldlt_base<T>::solve_inplace(matrix_base<T>& b) const
+		{
+			auto n = size();
+			auto k = b.cols();
+			assert(!singular && b.rows() == n);
+			kernel::trsm(true, true, n, k, factor.data(), factor.ld, b.data(), b.ld);
+			for (uint128_t i = 0; i < n; i++)
+			{
+				T pivot = T(1) / factor(i, i);
+				for (uint128_t j = 0; j < k; j++)
+					b(i, j) *= pivot;
+			}
+			kernel::trsm(false, true, n, k, factor.data(), factor.ld, b.data(), b.ld);
+			return b;
+		}
+
+		template<typename T>
+		inline qr_base<T>::qr_base(const matrix_base<T>& matr) :
+			factor(matr),
+			tau(std::min(matr.rows(), matr.cols()))
+		{
+			auto [m, n] = factor.size();
+			auto kmax = std::min(m, n);
+			T* a = factor.data();
+			for (uint128_t k = 0; k < kmax; k += QR_BLOCK_SIZE)
+			{
+				auto ke = std::min(k + QR_BLOCK_SIZE, kmax);
+				kernel::householder_panel(m, k, ke, a, factor.ld, tau.base.data());
+				if (ke < n)
+					kernel::householder_update(m, n, k, ke, a, factor.ld, tau.base.data());
+			}
+		}
+
+		template<typename T>
+		inline uint128_t qr_base<T>::rows() const
+		{
+			return factor.rows();
+		}
+
+		template<typename T>
+		inline uint128_t qr_base<T>::cols() const
+		{
+			return factor.cols();
+		}
+
+		template<typename T>
+		inline matrix_base<T> qr_base<T>::q() const
+		{
+			auto kmax = tau.size();
+			matrix_base<T> result(rows(), kmax);
+			result.fill_diagonal(T(1));
+			return apply_q(result);
+		}
+
+		template<typename T>
+		inline matrix_base<T> qr_base<T>::r() const
+		{
+			auto kmax = tau.size();
+			matrix_base<T> result(kmax, cols());
+			for (uint128_t i = 0; i < kmax; i++)
+				for (uint128_t j = i; j < cols(); j++)
+					result(i, j) = factor(i, j);
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T>& qr_base<T>::apply_q(vector_base<T>& b) const
+		{
+			assert(b.size() == rows());
+			kernel::householder_apply(false, rows(), tau.size(), factor.data(), factor.ld, tau.base.data(), b.base.data(), 1, 1);
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& qr_base<T>::apply_q(matrix_base<T>& b) const
+		{
+			assert(b.rows() == rows());
+			kernel::householder_apply(false, rows(), tau.size(), factor.data(), factor.ld, tau.base.data(), b.data(), b.ld, b.cols());
+			return b;
+		}
+
+		template<typename T>
+		inline vector_base<T>& qr_base<T>::apply_qh(vector_base<T>& b) const
+		{
+			assert(b.size() == rows());
+			kernel::householder_apply(true, rows(), tau.size(), factor.data(), factor.ld, tau.base.data(), b.base.data(), 1, 1);
+			return b;
+		}
+
+		template<typename T>
+		inline matrix_base<T>& qr_base<T>::apply_qh(matrix_base<T>& b) const
+		{
+			assert(b.rows() == rows());
+			kernel::householder_apply(true, rows(), tau.size(), factor.data(), factor.ld, tau.base.data(), b.data(), b.ld, b.cols());
+			return b;
+		}
+
+		template<typename T>
+		inline vector_base<T> qr_base<T>::solve(const vector_base<T>& b) const
+		{
+			auto n = cols();
+			assert(rows() >= n);
+			for (uint128_t i = 0; i < n; i++)
+				assert(factor(i, i) != 0 && "matrix is rank deficient");
+
+			vector_base<T> y(b);
+			apply_qh(y);
+			y.base.resize(n);
+			kernel::trsv(false, false, n, factor.data(), factor.ld, y.base.data());
+			return y;
+		}
+
+		template<typename T>
+		inline matrix_base<T> qr_base<T>::solve(const matrix_base<T>& b) const
+		{
+			auto n = cols();
+			auto k = b.cols();
+			assert(rows() >= n);
+			for (uint128_t i = 0; i < n; i++)
+				assert(factor(i, i) != 0 && "matrix is rank deficient");
+
+			matrix_base<T> y(b);
+			apply_qh(y);
+			matrix_base<T> x(n, k);
+			for (uint128_t i = 0; i < n; i++)
+				std::copy_n(y.data() + i * y.ld, k, x.data() + i * x.ld);
+			kernel::trsm(false, false, n, k, factor.data(), factor.ld, x.data(), x.ld);
+			return x;
+		}
+
+		template<typename T>
+		inline matrix_base<T> matrix_base<T>::inversed() const
+		{
+			return lu_base<T>(*this).inverse();
+		}
+	}
+
+	template<typename T>
+	inline base_type::lu_base<T> lu(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::lu_base<T>(matr);
+	}
+
+	template<typename T>
+	inline base_type::cholesky_base<T> cholesky(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::cholesky_base<T>(matr);
+	}
+
+	template<typename T>
+	inline base_type::ldlt_base<T> ldlt(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::ldlt_base<T>(matr);
+	}
+
+	template<typename T>
+	inline base_type::qr_base<T> qr(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::qr_base<T>(matr);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> lstsq(const base_type::matrix_base<T>& matr, const base_type::vector_base<T>& b)
+	{
+		return qr(matr).solve(b);
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> lstsq(const base_type::matrix_base<T>& matr, const base_type::matrix_base<T>& b)
+	{
+		return qr(matr).solve(b);
+	}
+
+	template<typename T>
+	inline bool cholesky_inplace(base_type::matrix_base<T>& matr)
+	{
+		assert(matr.is_square());
+		return kernel::hermitian_factor(false, matr.rows(), matr.data(), matr.ld);
+	}
+
+	template<typename T>
+	inline bool ldlt_inplace(base_type::matrix_base<T>& matr)
+	{
+		assert(matr.is_square());
+		return kernel::hermitian_factor(true, matr.rows(), matr.data(), matr.ld);
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> LU_decomposion(const base_type::matrix_base<T>& matr)
+	{
+		assert(matr.is_square());
+		auto n = matr.rows();
+		base_type::matrix_base<T> result(matr);
+		auto ld = result.ld;
+		T* a = result.data();
+
+		// no pivoting, every leading minor must be non-zero
+		for (uint128_t j = 0; j < n; j++)
+		{
+			assert(a[j * ld + j] != 0);
+			T pivot = T(1) / a[j * ld + j];
+			for (uint128_t i = j + 1; i < n; i++)
+			{
+				T* row = a + i * ld;
+				row[j] *= pivot;
+				kernel::row_axpy(n - j - 1, -row[j], a + j * ld + j + 1, row + j + 1);
+			}
+		}
+		return result;
+	}
+
+	template<typename T>
+	inline std::tuple<base_type::matrix_base<T>, base_type::matrix_base<T>> LUP_decomposion(const base_type::matrix_base<T>& matr)
+	{
+		auto factor = lu(matr);
+		return std::make_tuple(factor.lu, factor.permutation());
+	}
+}
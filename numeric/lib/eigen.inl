@@ -0,0 +1,279 @@
+#include "../include/eigen.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// Q^H A Q = T for hermitian A (lower triangle), d / e - diagonal / subdiagonal of T,
+		// reflector k is stored in column k below the subdiagonal, Q = H_0 ... H_{n-2}
+		template<typename T>
+		inline void hermitian_tridiagonal(uint128_t n, T* a, uint128_t ld, typing::real_type_t<T>* d, typing::real_type_t<T>* e, T* tau)
+		{
+			using R = typing::real_type_t<T>;
+
+			// rank-2 update A -= v w^H + w v^H of the previous step, not applied yet
+			std::vector<T> v(n), w(n), cv(n), cw(n), nv(n);
+			bool pending = false;
+
+			for (uint128_t k = 0; k < n; k++)
+			{
+				// column k gets the pending update first, the reflector is built from it
+				if (pending)
+					for (auto i = k; i < n; i++)
+						a[i * ld + k] -= v[i] * cw[k] + w[i] * cv[k];
+				d[k] = nm::real(a[k * ld + k]);
+				if (k + 1 == n)
+					break;
+
+				T alpha = a[(k + 1) * ld + k];
+				R xnorm2 = 0;
+				for (auto i = k + 2; i < n; i++)
+					xnorm2 += nm::real(nm::conj(a[i * ld + k]) * a[i * ld + k]);
+
+				bool reflect = !(xnorm2 == 0 && alpha == T(nm::real(alpha)));
+				if (reflect)
+				{
+					R beta = std::sqrt(nm::real(alpha * nm::conj(alpha)) + xnorm2);
+					if (nm::real(alpha) >= 0)
+						beta = -beta;
+
+					tau[k] = (T(beta) - alpha) / T(beta);
+					T scale = T(1) / (alpha - T(beta));
+					for (auto i = k + 2; i < n; i++)
+						a[i * ld + k] *= scale;
+					a[(k + 1) * ld + k] = beta;
+					e[k] = beta;
+
+					nv[k + 1] = 1;
+					for (auto i = k + 2; i < n; i++)
+						nv[i] = a[i * ld + k];
+				}
+				else
+				{
+					tau[k] = 0;
+					e[k] = nm::real(alpha);
+				}
+
+				// one pass over the rows of the trailing lower triangle:
+				// pending update of row i, then its share of p = A22 v (row i and, by symmetry, column i)
+				auto k1 = k + 1;
+				auto m = n - k1;
+				auto p = reduce_rows<T>(k1, n, m, m * m, [&](uint128_t i, T* acc)
+				{
+					T* row = a + i * ld + k1;
+					auto len = i - k1;
+					if (pending)
+					{
+						row_axpy(len + 1, -v[i], cw.data() + k1, row);
+						row_axpy(len + 1, -w[i], cv.data() + k1, row);
+					}
+					if (!reflect)
+						return;
+
+					T vi = nv[i];
+					acc[len] += row_dot(len, row, nv.data() + k1) + row[len] * vi;
+					if constexpr (typing::is_floating_point<T>::value)
+						row_axpy(len, vi, row, acc);
+					else
+					{
+						for (uint128_t j = 0; j < len; j++)
+							acc[j] += nm::conj(row[j]) * vi;
+					}
+				});
+
+				pending = reflect;
+				if (!reflect)
+					continue;
+
+				// w = tau p - tau / 2 (tau p, v) v
+				T t = tau[k];
+				T pv = 0;
+				for (uint128_t j = 0; j < m; j++)
+				{
+					p[j] *= t;
+					pv += nm::conj(p[j]) * nv[k1 + j];
+				}
+				T half = -T(0.5) * t * pv;
+				for (uint128_t j = 0; j < m; j++)
+				{
+					v[k1 + j] = nv[k1 + j];
+					w[k1 + j] = p[j] + half * nv[k1 + j];
+					cv[k1 + j] = nm::conj(v[k1 + j]);
+					cw[k1 + j] = nm::conj(w[k1 + j]);
+				}
+			}
+		}
+
+		// rows [first, first + count] of z are rotated by the sequence of rotations (c_r, s_r) in planes
+		// (first + r, first + r + 1); columns are processed in blocks, so both rows stay in cache
+		template<typename R>
+		inline void rotate_rows(uint128_t first, uint128_t count, const R* c, const R* s, R* z, uint128_t ldz, uint128_t nc)
+		{
+			constexpr uint128_t block = 64;
+			parallel::parallel_for(0, nc, 6 * count * nc, [&](uint128_t lo, uint128_t hi)
+			{
+				for (auto cb = lo; cb < hi; cb += block)
+				{
+					auto ce = std::min(cb + block, hi);
+					for (uint128_t r = 0; r < count; r++)
+					{
+						R* x = z + (first + r) * ldz;
+						R* y = x + ldz;
+						R cr = c[r];
+						R sr = s[r];
+						for (auto j = cb; j < ce; j++)
+						{
+							R t = x[j];
+							x[j] = cr * t - sr * y[j];
+							y[j] = sr * t + cr * y[j];
+						}
+					}
+				}
+			});
+		}
+
+		// implicit QR iteration with Wilkinson shift for symmetric tridiagonal (d, e),
+		// rotations are accumulated in the rows of z (Z^T) if z is not null; returns false if it does not converge
+		template<typename R>
+		inline bool tridiagonal_qr(uint128_t n, R* d, R* e, R* z, uint128_t ldz, uint128_t nz)
+		{
+			if (n < 2)
+				return true;
+
+			const R eps = std::numeric_limits<R>::epsilon();
+			auto small = [&](uint128_t i) { return nm::abs(e[i]) <= eps * (nm::abs(d[i]) + nm::abs(d[i + 1])); };
+
+			std::vector<R> cs(n), sn(n);
+			uint128_t sweeps = 0;
+			uint128_t end = n - 1;
+			while (end > 0)
+			{
+				if (small(end - 1))
+				{
+					e[end - 1] = 0;
+					end--;
+					continue;
+				}
+				if (sweeps++ >= 30 * n)
+					return false;
+
+				// unreduced block [start, end]
+				auto start = end - 1;
+				while (start > 0 && !small(start - 1))
+					start--;
+				if (start > 0)
+					e[start - 1] = 0;
+
+				// shift is the eigenvalue of the trailing 2 x 2 block closer to d[end]
+				R delta = (d[end - 1] - d[end]) / 2;
+				R b = e[end - 1];
+				R mu = d[end] - b * b / (delta + std::copysign(std::hypot(delta, b), delta));
+
+				// chase the bulge down the block
+				R x = d[start] - mu;
+				R y = e[start];
+				for (auto k = start; k < end; k++)
+				{
+					R r = std::hypot(x, y);
+					R c = r == 0 ? R(1) : x / r;
+					R s = r == 0 ? R(0) : -y / r;
+					if (k > start)
+						e[k - 1] = r;
+
+					R dk = d[k];
+					R ek = e[k];
+					R dn = d[k + 1];
+					d[k] = c * c * dk - 2 * c * s * ek + s * s * dn;
+					d[k + 1] = s * s * dk + 2 * c * s * ek + c * c * dn;
+					e[k] = c * s * (dk - dn) + (c * c - s * s) * ek;
+					if (k + 1 < end)
+					{
+						x = e[k];
+						y = -s * e[k + 1];
+						e[k + 1] *= c;
+					}
+					cs[k - start] = c;
+					sn[k - start] = s;
+				}
+				if (z)
+					rotate_rows(start, end - start, cs.data(), sn.data(), z, ldz, nz);
+			}
+			return true;
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline eigen_base<T>::eigen_base(const matrix_base<T>& matr, bool vectors) :
+			values(matr.rows()),
+			converged(true)
+		{
+			assert(matr.is_square());
+			auto n = matr.rows();
+			if (n == 0)
+				return;
+
+			matrix_base<T> a(matr);
+			std::vector<real_t> e(n);
+			std::vector<T> tau(n);
+			real_t* d = values.base.data();
+			kernel::hermitian_tridiagonal(n, a.data(), a.ld, d, e.data(), tau.data());
+
+			if (!vectors)
+			{
+				converged = kernel::tridiagonal_qr<real_t>(n, d, e.data(), nullptr, 0, 0);
+				std::sort(values.base.begin(), values.base.end());
+				return;
+			}
+
+			// T = Z diag(d) Z^T, Z^T is accumulated by rows
+			matrix_base<real_t> zt(n, n);
+			zt.fill_diagonal(1);
+			converged = kernel::tridiagonal_qr<real_t>(n, d, e.data(), zt.data(), zt.ld, n);
+
+			std::vector<uint128_t> order(n);
+			for (uint128_t i = 0; i < n; i++)
+				order[i] = i;
+			std::sort(order.begin(), order.end(), [&](uint128_t x, uint128_t y) { return d[x] < d[y]; });
+
+			// V = Q Z, columns sorted by eigenvalue
+			this->vectors = matrix_base<T>(n, n);
+			auto& v = this->vectors;
+			std::vector<real_t> sorted(n);
+			for (uint128_t j = 0; j < n; j++)
+			{
+				sorted[j] = d[order[j]];
+				const real_t* zrow = zt.data() + order[j] * zt.ld;
+				for (uint128_t i = 0; i < n; i++)
+					v(i, j) = zrow[i];
+			}
+			std::copy(sorted.begin(), sorted.end(), values.base.begin());
+			kernel::householder_apply(false, n - 1, n - 1, a.data() + a.ld, a.ld, tau.data(), v.data() + v.ld, v.ld, n);
+		}
+
+		template<typename T>
+		inline uint128_t eigen_base<T>::size() const
+		{
+			return values.size();
+		}
+
+		template<typename T>
+		inline bool eigen_base<T>::is_converged() const
+		{
+			return converged;
+		}
+	}
+
+	template<typename T>
+	inline base_type::eigen_base<T> eigh(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::eigen_base<T>(matr, true);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<typing::real_type_t<T>> eigvalsh(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::eigen_base<T>(matr, false).values;
+	}
+}
@@ -0,0 +1,622 @@
+#include "../include/expression.hpp"
+
+namespace nm
+{
+	namespace base_type
+	{
+		template<typename T>
+		inline const T& element(const vector_base<T>& vect, uint128_t i)
+		{
+			return vect.base[i];
+		}
+
+		template<typename T>
+		inline const T& element(const vector_view<T>& view, uint128_t i)
+		{
+			return view.base[int128_t(i) * view.step];
+		}
+
+		template<typename L, typename R, typename Op>
+		inline auto element(const vector_expr<L, R, Op>& expr, uint128_t i)
+		{
+			return expr[i];
+		}
+
+		template<typename S>
+		inline const S& element(const scalar_expr<S>& scalar, uint128_t)
+		{
+			return scalar.value;
+		}
+
+		template<typename T>
+		inline const T& element(const matrix_base<T>& matr, uint128_t i, uint128_t j)
+		{
+			return matr.base[i * matr.ld + j];
+		}
+
+		template<typename T>
+		inline const T& element(const matrix_view<T>& view, uint128_t i, uint128_t j)
+		{
+			return view(i, j);
+		}
+
+		template<typename L, typename R, typename Op>
+		inline auto element(const matrix_expr<L, R, Op>& expr, uint128_t i, uint128_t j)
+		{
+			return expr(i, j);
+		}
+
+		template<typename S>
+		inline const S& element(const scalar_expr<S>& scalar, uint128_t, uint128_t)
+		{
+			return scalar.value;
+		}
+
+		// elements at ptr + i * rstep + j * cstep, i < m, j < n
+		template<typename T>
+		inline footprint make_footprint(const T* ptr, uint128_t m, uint128_t n, int128_t rstep, int128_t cstep)
+		{
+			if (m == 0 || n == 0)
+				return { nullptr, nullptr, ptr, rstep, cstep, sizeof(T) };
+
+			int128_t rlast = (int128_t(m) - 1) * rstep;
+			int128_t clast = (int128_t(n) - 1) * cstep;
+			auto lo = reinterpret_cast<const char*>(ptr + std::min<int128_t>(rlast, 0) + std::min<int128_t>(clast, 0));
+			auto hi = reinterpret_cast<const char*>(ptr + std::max<int128_t>(rlast, 0) + std::max<int128_t>(clast, 0) + 1);
+			return { lo, hi, ptr, rstep, cstep, sizeof(T) };
+		}
+
+		template<typename T>
+		inline footprint storage(const vector_base<T>& vect)
+		{
+			return make_footprint(vect.base.data(), vect.size(), 1, 1, 0);
+		}
+
+		template<typename T>
+		inline footprint storage(const vector_view<T>& view)
+		{
+			return make_footprint(view.base, view.n, 1, view.step, 0);
+		}
+
+		template<typename T>
+		inline footprint storage(const matrix_base<T>& matr)
+		{
+			return make_footprint(matr.data(), matr.rows(), matr.cols(), matr.ld, 1);
+		}
+
+		template<typename T>
+		inline footprint storage(const matrix_view<T>& view)
+		{
+			return make_footprint(view.base, view.m, view.n, view.rstep, view.cstep);
+		}
+
+		template<typename E>
+		inline bool aliases(const footprint& dst, const E& operand)
+		{
+			auto src = storage(operand);
+			if (dst.lo == dst.hi || src.lo == src.hi || src.hi <= dst.lo || dst.hi <= src.lo)
+				return false;
+			return !(src.ptr == dst.ptr && src.rstep == dst.rstep && src.cstep == dst.cstep && src.elem == dst.elem);
+		}
+
+		template<typename S>
+		inline bool aliases(const footprint&, const scalar_expr<S>&)
+		{
+			return false;
+		}
+
+		template<typename L, typename R, typename Op>
+		inline bool aliases(const footprint& dst, const vector_expr<L, R, Op>& expr)
+		{
+			return aliases(dst, expr.lhs) || aliases(dst, expr.rhs);
+		}
+
+		template<typename L, typename R, typename Op>
+		inline bool aliases(const footprint& dst, const matrix_expr<L, R, Op>& expr)
+		{
+			return aliases(dst, expr.lhs) || aliases(dst, expr.rhs);
+		}
+
+		template<typename E>
+		inline int32_t update_order(const footprint& dst, const E& operand)
+		{
+			auto src = storage(operand);
+			auto stride = int128_t(dst.elem) * dst.rstep;
+			if (stride == 0 || dst.cstep != 0 || src.cstep != 0 || src.elem != dst.elem || src.rstep != dst.rstep)
+				return 0;
+
+			auto offset = static_cast<const char*>(dst.ptr) - static_cast<const char*>(src.ptr);
+			if (offset % stride != 0)
+				return 0;
+			return offset / stride > 0 ? -1 : 1;
+		}
+
+		template<typename L, typename R, typename Op>
+		inline int32_t update_order(const footprint&, const vector_expr<L, R, Op>&)
+		{
+			return 0;
+		}
+
+		template<typename S>
+		inline scalar_expr<S>::scalar_expr(const S& value) :
+			value(value)
+		{
+		}
+
+		template<typename L, typename R, typename Op>
+		inline vector_expr<L, R, Op>::vector_expr(const L& lhs, const R& rhs) :
+			lhs(lhs),
+			rhs(rhs)
+		{
+			if constexpr (typing::is_vector_operand_v<L> && typing::is_vector_operand_v<R>)
+				assert(lhs.size() == rhs.size());
+		}
+
+		template<typename L, typename R, typename Op>
+		inline uint128_t vector_expr<L, R, Op>::size() const
+		{
+			if constexpr (typing::is_vector_operand_v<L>)
+				return lhs.size();
+			else
+				return rhs.size();
+		}
+
+		template<typename L, typename R, typename Op>
+		inline typename vector_expr<L, R, Op>::value_type vector_expr<L, R, Op>::operator[](uint128_t i) const
+		{
+			return Op::apply(element(lhs, i), element(rhs, i));
+		}
+
+		template<typename L, typename R, typename Op>
+		inline vector_base<typename vector_expr<L, R, Op>::value_type> vector_expr<L, R, Op>::eval() const
+		{
+			return vector_base<value_type>(*this);
+		}
+
+		template<typename L, typename R, typename Op>
+		inline matrix_expr<L, R, Op>::matrix_expr(const L& lhs, const R& rhs) :
+			lhs(lhs),
+			rhs(rhs)
+		{
+			if constexpr (typing::is_matrix_operand_v<L> && typing::is_matrix_operand_v<R>)
+				assert(lhs.size() == rhs.size());
+		}
+
+		template<typename L, typename R, typename Op>
+		inline uint128_t matrix_expr<L, R, Op>::rows() const
+		{
+			if constexpr (typing::is_matrix_operand_v<L>)
+				return lhs.rows();
+			else
+				return rhs.rows();
+		}
+
+		template<typename L, typename R, typename Op>
+		inline uint128_t matrix_expr<L, R, Op>::cols() const
+		{
+			if constexpr (typing::is_matrix_operand_v<L>)
+				return lhs.cols();
+			else
+				return rhs.cols();
+		}
+
+		template<typename L, typename R, typename Op>
+		inline std::pair<uint128_t, uint128_t> matrix_expr<L, R, Op>::size() const
+		{
+			return std::make_pair(rows(), cols());
+		}
+
+		template<typename L, typename R, typename Op>
+		inline typename matrix_expr<L, R, Op>::value_type matrix_expr<L, R, Op>::operator()(uint128_t i, uint128_t j) const
+		{
+			return Op::apply(element(lhs, i, j), element(rhs, i, j));
+		}
+
+		template<typename L, typename R, typename Op>
+		inline matrix_base<typename matrix_expr<L, R, Op>::value_type> matrix_expr<L, R, Op>::eval() const
+		{
+			return matrix_base<value_type>(*this);
+		}
+
+		template<typename V>
+		inline const V& owning(const V& value)
+		{
+			return value;
+		}
+
+		template<typename V>
+		inline vector_base<typing::remove_cv_t<V>> owning(const vector_view<V>& view)
+		{
+			return view;
+		}
+
+		template<typename V>
+		inline matrix_base<typing::remove_cv_t<V>> owning(const matrix_view<V>& view)
+		{
+			return view;
+		}
+
+		template<typename L, typename R, typename Op>
+		inline auto owning(const vector_expr<L, R, Op>& expr)
+		{
+			return expr.eval();
+		}
+
+		template<typename L, typename R, typename Op>
+		inline auto owning(const matrix_expr<L, R, Op>& expr)
+		{
+			return expr.eval();
+		}
+
+		template<typename E, typing::require<typing::is_vector_operand_v<E>>>
+		inline auto operator-(const E& vect)
+		{
+			using S = scalar_expr<typename E::value_type>;
+			return vector_expr<E, S, expr_op::neg>(vect, S(0));
+		}
+
+		template<typename E, typing::require<typing::is_matrix_operand_v<E>>>
+		inline auto operator-(const E& matr)
+		{
+			using S = scalar_expr<typename E::value_type>;
+			return matrix_expr<E, S, expr_op::neg>(matr, S(0));
+		}
+
+		template<typename L, typename R, typing::require<typing::is_vector_operand_v<L> && typing::is_vector_operand_v<R>>>
+		inline auto operator+(const L& lhs, const R& rhs)
+		{
+			return vector_expr<L, R, expr_op::add>(lhs, rhs);
+		}
+
+		template<typename L, typename R, typing::require<typing::is_vector_operand_v<L> && typing::is_vector_operand_v<R>>>
+		inline auto operator-(const L& lhs, const R& rhs)
+		{
+			return vector_expr<L, R, expr_op::sub>(lhs, rhs);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator+(const L& vect, const S& value)
+		{
+			return vector_expr<L, scalar_expr<S>, expr_op::add>(vect, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator-(const L& vect, const S& value)
+		{
+			return vector_expr<L, scalar_expr<S>, expr_op::sub>(vect, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator*(const L& vect, const S& value)
+		{
+			return vector_expr<L, scalar_expr<S>, expr_op::mul>(vect, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_vector_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator/(const L& vect, const S& value)
+		{
+			return vector_expr<L, scalar_expr<S>, expr_op::div>(vect, value);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>>>
+		inline auto operator+(const S& value, const R& vect)
+		{
+			return vector_expr<scalar_expr<S>, R, expr_op::add>(value, vect);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>>>
+		inline auto operator-(const S& value, const R& vect)
+		{
+			return vector_expr<scalar_expr<S>, R, expr_op::sub>(value, vect);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>>>
+		inline auto operator*(const S& value, const R& vect)
+		{
+			return vector_expr<scalar_expr<S>, R, expr_op::mul>(value, vect);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_vector_operand_v<R>>>
+		inline auto operator/(const S& value, const R& vect)
+		{
+			return vector_expr<scalar_expr<S>, R, expr_op::div>(value, vect);
+		}
+
+		template<typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && typing::is_matrix_operand_v<R>>>
+		inline auto operator+(const L& lhs, const R& rhs)
+		{
+			return matrix_expr<L, R, expr_op::add>(lhs, rhs);
+		}
+
+		template<typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && typing::is_matrix_operand_v<R>>>
+		inline auto operator-(const L& lhs, const R& rhs)
+		{
+			return matrix_expr<L, R, expr_op::sub>(lhs, rhs);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator+(const L& matr, const S& value)
+		{
+			return matrix_expr<L, scalar_expr<S>, expr_op::add>(matr, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator-(const L& matr, const S& value)
+		{
+			return matrix_expr<L, scalar_expr<S>, expr_op::sub>(matr, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator*(const L& matr, const S& value)
+		{
+			return matrix_expr<L, scalar_expr<S>, expr_op::mul>(matr, value);
+		}
+
+		template<typename L, typename S, typing::require<typing::is_matrix_operand_v<L> && typing::is_scalar_v<S>>>
+		inline auto operator/(const L& matr, const S& value)
+		{
+			return matrix_expr<L, scalar_expr<S>, expr_op::div>(matr, value);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>>>
+		inline auto operator+(const S& value, const R& matr)
+		{
+			return matrix_expr<scalar_expr<S>, R, expr_op::add>(value, matr);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>>>
+		inline auto operator-(const S& value, const R& matr)
+		{
+			return matrix_expr<scalar_expr<S>, R, expr_op::sub>(value, matr);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>>>
+		inline auto operator*(const S& value, const R& matr)
+		{
+			return matrix_expr<scalar_expr<S>, R, expr_op::mul>(value, matr);
+		}
+
+		template<typename S, typename R, typing::require<typing::is_scalar_v<S> && typing::is_matrix_operand_v<R>>>
+		inline auto operator/(const S& value, const R& matr)
+		{
+			return matrix_expr<scalar_expr<S>, R, expr_op::div>(value, matr);
+		}
+
+		template<typename T>
+		inline vector_base<T> operator-(vector_base<T>&& vect)
+		{
+			vect = -std::as_const(vect);
+			return std::move(vect);
+		}
+
+		template<typename T, typename R, typing::require<typing::is_vector_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>>>
+		inline vector_base<T> operator+(vector_base<T>&& lhs, const R& rhs)
+		{
+			lhs += rhs;
+			return std::move(lhs);
+		}
+
+		template<typename T, typename R, typing::require<typing::is_vector_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>>>
+		inline vector_base<T> operator-(vector_base<T>&& lhs, const R& rhs)
+		{
+			lhs -= rhs;
+			return std::move(lhs);
+		}
+
+		template<typename L, typename T, typing::require<typing::is_vector_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>>>
+		inline vector_base<T> operator+(const L& lhs, vector_base<T>&& rhs)
+		{
+			rhs = lhs + std::as_const(rhs);
+			return std::move(rhs);
+		}
+
+		template<typename L, typename T, typing::require<typing::is_vector_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>>>
+		inline vector_base<T> operator-(const L& lhs, vector_base<T>&& rhs)
+		{
+			rhs = lhs - std::as_const(rhs);
+			return std::move(rhs);
+		}
+
+		template<typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>>>
+		inline auto operator+(vector_base<T>&& lhs, vector_base<V>&& rhs)
+		{
+			if constexpr (typing::keeps_type_v<T, V>)
+				return std::move(lhs) + std::as_const(rhs);
+			else
+				return std::as_const(lhs) + std::move(rhs);
+		}
+
+		template<typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>>>
+		inline auto operator-(vector_base<T>&& lhs, vector_base<V>&& rhs)
+		{
+			if constexpr (typing::keeps_type_v<T, V>)
+				return std::move(lhs) - std::as_const(rhs);
+			else
+				return std::as_const(lhs) - std::move(rhs);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator+(vector_base<T>&& vect, const S& value)
+		{
+			vect += T(value);
+			return std::move(vect);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator-(vector_base<T>&& vect, const S& value)
+		{
+			vect -= T(value);
+			return std::move(vect);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator*(vector_base<T>&& vect, const S& value)
+		{
+			vect *= T(value);
+			return std::move(vect);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator/(vector_base<T>&& vect, const S& value)
+		{
+			vect /= T(value);
+			return std::move(vect);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator+(const S& value, vector_base<T>&& vect)
+		{
+			vect += T(value);
+			return std::move(vect);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator-(const S& value, vector_base<T>&& vect)
+		{
+			vect = value - std::as_const(vect);
+			return std::move(vect);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator*(const S& value, vector_base<T>&& vect)
+		{
+			vect *= T(value);
+			return std::move(vect);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline vector_base<T> operator/(const S& value, vector_base<T>&& vect)
+		{
+			vect = value / std::as_const(vect);
+			return std::move(vect);
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(matrix_base<T>&& matr)
+		{
+			matr = -std::as_const(matr);
+			return std::move(matr);
+		}
+
+		template<typename T, typename R, typing::require<typing::is_matrix_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>>>
+		inline matrix_base<T> operator+(matrix_base<T>&& lhs, const R& rhs)
+		{
+			lhs += rhs;
+			return std::move(lhs);
+		}
+
+		template<typename T, typename R, typing::require<typing::is_matrix_operand_v<R> && typing::keeps_type_v<T, typename R::value_type>>>
+		inline matrix_base<T> operator-(matrix_base<T>&& lhs, const R& rhs)
+		{
+			lhs -= rhs;
+			return std::move(lhs);
+		}
+
+		template<typename L, typename T, typing::require<typing::is_matrix_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>>>
+		inline matrix_base<T> operator+(const L& lhs, matrix_base<T>&& rhs)
+		{
+			rhs = lhs + std::as_const(rhs);
+			return std::move(rhs);
+		}
+
+		template<typename L, typename T, typing::require<typing::is_matrix_operand_v<L> && typing::keeps_type_v<T, typename L::value_type>>>
+		inline matrix_base<T> operator-(const L& lhs, matrix_base<T>&& rhs)
+		{
+			rhs = lhs - std::as_const(rhs);
+			return std::move(rhs);
+		}
+
+		template<typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>>>
+		inline auto operator+(matrix_base<T>&& lhs, matrix_base<V>&& rhs)
+		{
+			if constexpr (typing::keeps_type_v<T, V>)
+				return std::move(lhs) + std::as_const(rhs);
+			else
+				return std::as_const(lhs) + std::move(rhs);
+		}
+
+		template<typename T, typename V, typing::require<typing::keeps_type_v<T, V> || typing::keeps_type_v<V, T>>>
+		inline auto operator-(matrix_base<T>&& lhs, matrix_base<V>&& rhs)
+		{
+			if constexpr (typing::keeps_type_v<T, V>)
+				return std::move(lhs) - std::as_const(rhs);
+			else
+				return std::as_const(lhs) - std::move(rhs);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator+(matrix_base<T>&& matr, const S& value)
+		{
+			matr += T(value);
+			return std::move(matr);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator-(matrix_base<T>&& matr, const S& value)
+		{
+			matr -= T(value);
+			return std::move(matr);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator*(matrix_base<T>&& matr, const S& value)
+		{
+			matr *= T(value);
+			return std::move(matr);
+		}
+
+		template<typename T, typename S, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator/(matrix_base<T>&& matr, const S& value)
+		{
+			matr /= T(value);
+			return std::move(matr);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator+(const S& value, matrix_base<T>&& matr)
+		{
+			matr += T(value);
+			return std::move(matr);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator-(const S& value, matrix_base<T>&& matr)
+		{
+			matr = value - std::as_const(matr);
+			return std::move(matr);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator*(const S& value, matrix_base<T>&& matr)
+		{
+			matr *= T(value);
+			return std::move(matr);
+		}
+
+		template<typename S, typename T, typing::require<typing::is_scalar_v<S> && typing::keeps_type_v<T, S>>>
+		inline matrix_base<T> operator/(const S& value, matrix_base<T>&& matr)
+		{
+			matr = value / std::as_const(matr);
+			return std::move(matr);
+		}
+
+		template<typename L, typename R, typing::require<typing::is_matrix_operand_v<L> && (typing::is_matrix_operand_v<R> || typing::is_vector_operand_v<R>)
+			&& !(typing::is_owning_v<L> && typing::is_owning_v<R>)>>
+		inline auto operator*(const L& lhs, const R& rhs)
+		{
+			return owning(lhs) * owning(rhs);
+		}
+	}
+}
+
+template<typename L, typename R, typename Op>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::vector_expr<L, R, Op>& expr)
+{
+	return out << expr.eval();
+}
+
+template<typename L, typename R, typename Op>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::matrix_expr<L, R, Op>& expr)
+{
+	return out << expr.eval();
+}
@@ -0,0 +1,464 @@
+#include "../include/fft.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// exp(-2 pi i k / n), k is reduced first, so large tables keep full precision
+		template<typename T>
+		inline base_type::complex_base<T> unit_root(uint128_t k, uint128_t n)
+		{
+			const long double angle = -2.0L * 3.14159265358979323846264338327950288L * (long double)(k % n) / (long double)n;
+			return base_type::complex_base<T>(T(std::cos(angle)), T(std::sin(angle)));
+		}
+
+		// one Stockham pass of radix p over a transform of length p * m with stride s:
+		// y[q + s (p k + u)] = w^(u k) sum_t x[q + s (k + t m)] r^(t u), r = exp(-2 pi i / p)
+		template<typename T>
+		inline void fft_pass(uint128_t m, uint128_t s, uint128_t p,
+			const base_type::complex_base<T>* x, base_type::complex_base<T>* y, const base_type::complex_base<T>* tw)
+		{
+			using C = base_type::complex_base<T>;
+			auto mul = [](const C& a, const C& b) { return C(a.real * b.real - a.imag * b.imag, a.real * b.imag + a.imag * b.real); };
+
+			if (p == 2)
+			{
+				for (uint128_t k = 0; k < m; k++)
+				{
+					C w1 = tw[k];
+					const C* x0 = x + s * k;
+					const C* x1 = x0 + s * m;
+					C* y0 = y + s * 2 * k;
+					C* y1 = y0 + s;
+					for (uint128_t q = 0; q < s; q++)
+					{
+						C a = x0[q];
+						C b = x1[q];
+						y0[q] = C(a.real + b.real, a.imag + b.imag);
+						y1[q] = mul(C(a.real - b.real, a.imag - b.imag), w1);
+					}
+				}
+			}
+			else if (p == 4)
+			{
+				for (uint128_t k = 0; k < m; k++)
+				{
+					C w1 = tw[3 * k];
+					C w2 = tw[3 * k + 1];
+					C w3 = tw[3 * k + 2];
+					const C* x0 = x + s * k;
+					C* y0 = y + s * 4 * k;
+					for (uint128_t q = 0; q < s; q++)
+					{
+						C a0 = x0[q];
+						C a1 = x0[q + s * m];
+						C a2 = x0[q + 2 * s * m];
+						C a3 = x0[q + 3 * s * m];
+						C s02(a0.real + a2.real, a0.imag + a2.imag);
+						C d02(a0.real - a2.real, a0.imag - a2.imag);
+						C s13(a1.real + a3.real, a1.imag + a3.imag);
+						C d13(a1.imag - a3.imag, a3.real - a1.real);		// -i (a1 - a3)
+						y0[q] = C(s02.real + s13.real, s02.imag + s13.imag);
+						y0[q + s] = mul(C(d02.real + d13.real, d02.imag + d13.imag), w1);
+						y0[q + 2 * s] = mul(C(s02.real - s13.real, s02.imag - s13.imag), w2);
+						y0[q + 3 * s] = mul(C(d02.real - d13.real, d02.imag - d13.imag), w3);
+					}
+				}
+			}
+			else if (p == 3)
+			{
+				const T half_sqrt3 = T(0.86602540378443864676372317075293618L);
+				for (uint128_t k = 0; k < m; k++)
+				{
+					C w1 = tw[2 * k];
+					C w2 = tw[2 * k + 1];
+					const C* x0 = x + s * k;
+					C* y0 = y + s * 3 * k;
+					for (uint128_t q = 0; q < s; q++)
+					{
+						C a0 = x0[q];
+						C a1 = x0[q + s * m];
+						C a2 = x0[q + 2 * s * m];
+						C t1(a1.real + a2.real, a1.imag + a2.imag);
+						C t2(a0.real - t1.real / 2, a0.imag - t1.imag / 2);
+						C t3(half_sqrt3 * (a1.imag - a2.imag), half_sqrt3 * (a2.real - a1.real));		// -i sin(2 pi / 3) (a1 - a2)
+						y0[q] = C(a0.real + t1.real, a0.imag + t1.imag);
+						y0[q + s] = mul(C(t2.real + t3.real, t2.imag + t3.imag), w1);
+						y0[q + 2 * s] = mul(C(t2.real - t3.real, t2.imag - t3.imag), w2);
+					}
+				}
+			}
+			else
+			{
+				C roots[FFT_MAX_RADIX];
+				C a[FFT_MAX_RADIX];
+				for (uint128_t t = 0; t < p; t++)
+					roots[t] = unit_root<T>(t, p);
+
+				for (uint128_t k = 0; k < m; k++)
+				{
+					const C* w = tw + (p - 1) * k;
+					const C* x0 = x + s * k;
+					C* y0 = y + s * p * k;
+					for (uint128_t q = 0; q < s; q++)
+					{
+						for (uint128_t t = 0; t < p; t++)
+							a[t] = x0[q + t * s * m];
+						for (uint128_t u = 0; u < p; u++)
+						{
+							C sum = a[0];
+							uint128_t r = 0;
+							for (uint128_t t = 1; t < p; t++)
+							{
+								r += u;
+								if (r >= p)
+									r -= p;
+								sum = C(sum.real + a[t].real * roots[r].real - a[t].imag * roots[r].imag,
+									sum.imag + a[t].real * roots[r].imag + a[t].imag * roots[r].real);
+							}
+							y0[q + u * s] = u ? mul(sum, w[u - 1]) : sum;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline fft_plan<T>::fft_plan(uint128_t n) :
+			n(n)
+		{
+			if (n < 2)
+				return;
+
+			// radices 4 first, then 2, 3 and the other primes
+			auto rest = n;
+			while (rest % 4 == 0)
+			{
+				radices.push_back(4);
+				rest /= 4;
+			}
+			for (uint128_t p = 2; p * p <= rest; p += (p == 2 ? 1 : 2))
+			{
+				while (rest % p == 0)
+				{
+					radices.push_back(p);
+					rest /= p;
+				}
+			}
+			if (rest > 1)
+				radices.push_back(rest);
+
+			bool small = true;
+			for (auto p : radices)
+				small = small && p <= FFT_MAX_RADIX;
+
+			if (!small)
+			{
+				// Bluestein: X_k = c_k sum_j (x_j c_j) conj(c_{k - j}), the convolution has length m >= 2n - 1
+				radices.clear();
+				uint128_t m = 1;
+				while (m < 2 * n - 1)
+					m *= 2;
+				inner.emplace_back(m);
+
+				chirp.resize(n);
+				for (uint128_t k = 0; k < n; k++)
+				{
+					// exp(-i pi k^2 / n) = unit_root(k^2 mod 2n, 2n)
+					auto k2 = (k * k) % (2 * n);
+					chirp[k] = kernel::unit_root<T>(k2, 2 * n);
+				}
+
+				spectrum.assign(m, value_type(0));
+				spectrum[0] = nm::conj(chirp[0]);
+				for (uint128_t k = 1; k < n; k++)
+					spectrum[k] = spectrum[m - k] = nm::conj(chirp[k]);
+				std::vector<value_type> scratch(inner[0].workspace());
+				inner[0].execute(spectrum.data(), scratch.data());
+				for (auto& value : spectrum)
+					value /= T(m);
+			}
+			else
+			{
+				// pass with radix p over length L = p * m: w_L^(u k), u = 1 .. p - 1, k < m
+				auto length = n;
+				for (auto p : radices)
+				{
+					auto m = length / p;
+					for (uint128_t k = 0; k < m; k++)
+						for (uint128_t u = 1; u < p; u++)
+							twiddles.push_back(kernel::unit_root<T>(u * k, length));
+					length = m;
+				}
+			}
+			work.resize(workspace());
+		}
+
+		template<typename T>
+		inline uint128_t fft_plan<T>::size() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline uint128_t fft_plan<T>::workspace() const
+		{
+			if (inner.empty())
+				return n;
+			return 2 * inner[0].size();
+		}
+
+		template<typename T>
+		inline bool fft_plan<T>::is_bluestein() const
+		{
+			return !inner.empty();
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::execute(value_type* x, value_type* work) const
+		{
+			value_type* src = x;
+			value_type* dst = work;
+			const value_type* tw = twiddles.data();
+			uint128_t length = n;
+			uint128_t stride = 1;
+			for (auto p : radices)
+			{
+				auto m = length / p;
+				kernel::fft_pass<T>(m, stride, p, src, dst, tw);
+				tw += (p - 1) * m;
+				std::swap(src, dst);
+				length = m;
+				stride *= p;
+			}
+			if (src != x)
+				std::copy_n(src, n, x);
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::transform(value_type* x, value_type* work, bool inverse) const
+		{
+			if (n < 2)
+				return;
+
+			// inverse transform is conj(F conj(x)) / n
+			if (inverse)
+				for (uint128_t k = 0; k < n; k++)
+					x[k].imag = -x[k].imag;
+
+			if (inner.empty())
+				execute(x, work);
+			else
+			{
+				auto m = inner[0].size();
+				value_type* a = work;
+				for (uint128_t k = 0; k < n; k++)
+					a[k] = x[k] * chirp[k];
+				std::fill(a + n, a + m, value_type(0));
+
+				// a * b = F^-1 (F a F b), F^-1 y = conj(F conj(y)), 1 / m is in the spectrum
+				inner[0].execute(a, work + m);
+				for (uint128_t k = 0; k < m; k++)
+					a[k] = nm::conj(a[k] * spectrum[k]);
+				inner[0].execute(a, work + m);
+				for (uint128_t k = 0; k < n; k++)
+					x[k] = nm::conj(a[k]) * chirp[k];
+			}
+
+			if (inverse)
+			{
+				T scale = T(1) / T(n);
+				for (uint128_t k = 0; k < n; k++)
+					x[k] = value_type(x[k].real * scale, -x[k].imag * scale);
+			}
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::forward(vector_base<value_type>& x)
+		{
+			assert(x.size() == n);
+			transform(x.base.data(), work.data(), false);
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::inverse(vector_base<value_type>& x)
+		{
+			assert(x.size() == n);
+			transform(x.base.data(), work.data(), true);
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::forward(matrix_base<value_type>& signals)
+		{
+			assert(signals.cols() == n);
+			parallel::parallel_for(0, signals.rows(), signals.rows() * n * (radices.size() + 1), [&](uint128_t lo, uint128_t hi)
+			{
+				std::vector<value_type> scratch(workspace());
+				for (auto i = lo; i < hi; i++)
+					transform(signals.data() + i * signals.ld, scratch.data(), false);
+			});
+		}
+
+		template<typename T>
+		inline void fft_plan<T>::inverse(matrix_base<value_type>& signals)
+		{
+			assert(signals.cols() == n);
+			parallel::parallel_for(0, signals.rows(), signals.rows() * n * (radices.size() + 1), [&](uint128_t lo, uint128_t hi)
+			{
+				std::vector<value_type> scratch(workspace());
+				for (auto i = lo; i < hi; i++)
+					transform(signals.data() + i * signals.ld, scratch.data(), true);
+			});
+		}
+
+		template<typename T>
+		inline rfft_plan<T>::rfft_plan(uint128_t n) :
+			n(n),
+			plan(n % 2 ? n : n / 2),
+			buffer(n % 2 ? n : n / 2)
+		{
+			if (n % 2 == 0)
+			{
+				twiddles.resize(n / 2);
+				for (uint128_t k = 0; k < n / 2; k++)
+					twiddles[k] = kernel::unit_root<T>(k, n);
+			}
+		}
+
+		template<typename T>
+		inline uint128_t rfft_plan<T>::size() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline void rfft_plan<T>::forward(const vector_base<T>& signal, vector_base<value_type>& spectrum)
+		{
+			assert(signal.size() == n);
+			if (spectrum.size() != n / 2 + 1)
+				spectrum.base.resize(n / 2 + 1);
+			if (n == 0)
+				return;
+
+			const T* x = signal.base.data();
+			value_type* out = spectrum.base.data();
+			value_type* z = buffer.data();
+			if (n % 2)
+			{
+				for (uint128_t k = 0; k < n; k++)
+					z[k] = value_type(x[k]);
+				plan.transform(z, plan.work.data(), false);
+				std::copy_n(z, n / 2 + 1, out);
+				return;
+			}
+
+			// z_j = x_2j + i x_2j+1, Z = E + i O, X_k = E_k + w^k O_k
+			auto h = n / 2;
+			for (uint128_t j = 0; j < h; j++)
+				z[j] = value_type(x[2 * j], x[2 * j + 1]);
+			plan.transform(z, plan.work.data(), false);
+
+			out[0] = value_type(z[0].real + z[0].imag);
+			out[h] = value_type(z[0].real - z[0].imag);
+			for (uint128_t k = 1; k < h; k++)
+			{
+				// E_k = (Z_k + conj Z_h-k) / 2, O_k = -i (Z_k - conj Z_h-k) / 2
+				value_type a = z[k];
+				value_type b = nm::conj(z[h - k]);
+				value_type e((a.real + b.real) / 2, (a.imag + b.imag) / 2);
+				value_type o((a.imag - b.imag) / 2, (b.real - a.real) / 2);
+				out[k] = e + twiddles[k] * o;
+			}
+		}
+
+		template<typename T>
+		inline void rfft_plan<T>::inverse(const vector_base<value_type>& spectrum, vector_base<T>& signal)
+		{
+			assert(spectrum.size() == n / 2 + 1);
+			if (signal.size() != n)
+				signal.base.resize(n);
+			if (n == 0)
+				return;
+
+			const value_type* in = spectrum.base.data();
+			T* x = signal.base.data();
+			value_type* z = buffer.data();
+			if (n % 2)
+			{
+				// the other half of the spectrum of a real signal is conjugate
+				for (uint128_t k = 0; k <= n / 2; k++)
+					z[k] = in[k];
+				for (uint128_t k = n / 2 + 1; k < n; k++)
+					z[k] = nm::conj(in[n - k]);
+				plan.transform(z, plan.work.data(), true);
+				for (uint128_t k = 0; k < n; k++)
+					x[k] = z[k].real;
+				return;
+			}
+
+			// E_k = (X_k + conj X_h-k) / 2, O_k = (X_k - conj X_h-k) / (2 w^k), Z = E + i O
+			auto h = n / 2;
+			for (uint128_t k = 0; k < h; k++)
+			{
+				value_type a = in[k];
+				value_type b = nm::conj(in[h - k]);
+				value_type e((a.real + b.real) / 2, (a.imag + b.imag) / 2);
+				value_type o = value_type((a.real - b.real) / 2, (a.imag - b.imag) / 2) * nm::conj(twiddles[k]);
+				z[k] = value_type(e.real - o.imag, e.imag + o.real);
+			}
+			plan.transform(z, plan.work.data(), true);
+			for (uint128_t j = 0; j < h; j++)
+			{
+				x[2 * j] = z[j].real;
+				x[2 * j + 1] = z[j].imag;
+			}
+		}
+
+		template<typename T>
+		inline vector_base<typename rfft_plan<T>::value_type> rfft_plan<T>::forward(const vector_base<T>& signal)
+		{
+			vector_base<value_type> spectrum(n / 2 + 1);
+			forward(signal, spectrum);
+			return spectrum;
+		}
+
+		template<typename T>
+		inline vector_base<T> rfft_plan<T>::inverse(const vector_base<value_type>& spectrum)
+		{
+			vector_base<T> signal(n);
+			inverse(spectrum, signal);
+			return signal;
+		}
+	}
+
+	template<typename T>
+	inline base_type::vector_base<base_type::complex_base<T>> fft(const base_type::vector_base<base_type::complex_base<T>>& x)
+	{
+		base_type::vector_base<base_type::complex_base<T>> result(x);
+		base_type::fft_plan<T>(x.size()).forward(result);
+		return result;
+	}
+
+	template<typename T>
+	inline base_type::vector_base<base_type::complex_base<T>> ifft(const base_type::vector_base<base_type::complex_base<T>>& x)
+	{
+		base_type::vector_base<base_type::complex_base<T>> result(x);
+		base_type::fft_plan<T>(x.size()).inverse(result);
+		return result;
+	}
+
+	template<typename T>
+	inline base_type::vector_base<base_type::complex_base<T>> rfft(const base_type::vector_base<T>& x)
+	{
+		return base_type::rfft_plan<T>(x.size()).forward(x);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> irfft(const base_type::vector_base<base_type::complex_base<T>>& x, uint128_t n)
+	{
+		return base_type::rfft_plan<T>(n).inverse(x);
+	}
+}
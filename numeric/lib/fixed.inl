@@ -0,0 +1,642 @@
+#include "../include/fixed.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// |x| usable in constant expressions for real T (std::abs is not constexpr before C++23)
+		template<typename T>
+		constexpr auto magnitude(const T& x)
+		{
+			if constexpr (typing::is_complex<T>::value)
+				return nm::abs(x);
+			else
+				return x < T(0) ? -x : x;
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>::fixed_vector() :
+			base{}
+		{
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>::fixed_vector(T value) :
+			base{}
+		{
+			for (uint128_t i = 0; i < N; i++)
+				base[i] = value;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>::fixed_vector(const std::initializer_list<T>& rawvect) :
+			base{}
+		{
+			assert(rawvect.size() == N);
+			uint128_t i = 0;
+			for (auto& value : rawvect)
+				base[i++] = value;
+		}
+
+		template<typename T, uint128_t N>
+		inline fixed_vector<T, N>::fixed_vector(const vector_base<T>& vect) :
+			base{}
+		{
+			assert(vect.size() == N);
+			std::copy_n(vect.base.data(), N, base);
+		}
+
+		template<typename T, uint128_t N>
+		inline fixed_vector<T, N>::operator vector_base<T>() const
+		{
+			return vector_base<T>(std::vector<T>(base, base + N));
+		}
+
+		template<typename T, uint128_t N>
+		constexpr uint128_t fixed_vector<T, N>::size()
+		{
+			return N;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr T& fixed_vector<T, N>::operator [](uint128_t i)
+		{
+			return base[i];
+		}
+
+		template<typename T, uint128_t N>
+		constexpr const T& fixed_vector<T, N>::operator [](uint128_t i) const
+		{
+			return base[i];
+		}
+
+		template<typename T, uint128_t N>
+		constexpr T* fixed_vector<T, N>::data()
+		{
+			return base;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr const T* fixed_vector<T, N>::data() const
+		{
+			return base;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr T fixed_vector<T, N>::dot(const fixed_vector& oth) const
+		{
+			T result = 0;
+			for (uint128_t i = 0; i < N; i++)
+				result += base[i] * oth.base[i];
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::cross(const fixed_vector& oth) const
+		{
+			static_assert(N == 3, "cross product is defined for 3-vectors only!");
+			return fixed_vector({
+				base[1] * oth.base[2] - base[2] * oth.base[1],
+				base[2] * oth.base[0] - base[0] * oth.base[2],
+				base[0] * oth.base[1] - base[1] * oth.base[0]
+			});
+		}
+
+		template<typename T, uint128_t N>
+		constexpr T fixed_vector<T, N>::sumsq() const
+		{
+			T result = 0;
+			for (uint128_t i = 0; i < N; i++)
+				result += base[i] * nm::conj(base[i]);
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		inline T fixed_vector<T, N>::norm2() const
+		{
+			return std::sqrt(sumsq());
+		}
+
+		template<typename T, uint128_t N>
+		inline fixed_vector<T, N> fixed_vector<T, N>::normalized() const
+		{
+			return *this / norm2();
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::operator -() const
+		{
+			fixed_vector result;
+			for (uint128_t i = 0; i < N; i++)
+				result.base[i] = -base[i];
+			return result;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>& fixed_vector<T, N>::operator +=(const fixed_vector& oth)
+		{
+			for (uint128_t i = 0; i < N; i++)
+				base[i] += oth.base[i];
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>& fixed_vector<T, N>::operator -=(const fixed_vector& oth)
+		{
+			for (uint128_t i = 0; i < N; i++)
+				base[i] -= oth.base[i];
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>& fixed_vector<T, N>::operator *=(const T& value)
+		{
+			for (uint128_t i = 0; i < N; i++)
+				base[i] *= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N>& fixed_vector<T, N>::operator /=(const T& value)
+		{
+			for (uint128_t i = 0; i < N; i++)
+				base[i] /= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::operator +(const fixed_vector& oth) const
+		{
+			fixed_vector result(*this);
+			return result += oth;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::operator -(const fixed_vector& oth) const
+		{
+			fixed_vector result(*this);
+			return result -= oth;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::operator *(const T& value) const
+		{
+			fixed_vector result(*this);
+			return result *= value;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_vector<T, N>::operator /(const T& value) const
+		{
+			fixed_vector result(*this);
+			return result /= value;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr bool fixed_vector<T, N>::operator ==(const fixed_vector& oth) const
+		{
+			for (uint128_t i = 0; i < N; i++)
+				if (base[i] != oth.base[i])
+					return false;
+			return true;
+		}
+
+		template<typename T, uint128_t N>
+		constexpr bool fixed_vector<T, N>::operator !=(const fixed_vector& oth) const
+		{
+			return !(*this == oth);
+		}
+
+		template<typename T, uint128_t N>
+		constexpr fixed_vector<T, N> operator *(const T& value, const fixed_vector<T, N>& vect)
+		{
+			return vect * value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>::fixed_matrix() :
+			base{}
+		{
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>::fixed_matrix(T value) :
+			base{}
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				base[i] = value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>::fixed_matrix(const std::initializer_list<std::initializer_list<T>>& rawmatr) :
+			base{}
+		{
+			assert(rawmatr.size() == M);
+			uint128_t i = 0;
+			for (auto& row : rawmatr)
+			{
+				assert(row.size() == N);
+				uint128_t j = 0;
+				for (auto& value : row)
+					base[i * N + j++] = value;
+				i++;
+			}
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline fixed_matrix<T, M, N>::fixed_matrix(const matrix_base<T>& matr) :
+			base{}
+		{
+			assert(matr.rows() == M && matr.cols() == N);
+			for (uint128_t i = 0; i < M; i++)
+				std::copy_n(matr.data() + i * matr.ld, N, base + i * N);
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		inline fixed_matrix<T, M, N>::operator matrix_base<T>() const
+		{
+			matrix_base<T> result(M, N);
+			for (uint128_t i = 0; i < M; i++)
+				std::copy_n(base + i * N, N, result.data() + i * result.ld);
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::identity()
+		{
+			fixed_matrix result;
+			for (uint128_t i = 0; i < M && i < N; i++)
+				result.base[i * N + i] = T(1);
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr uint128_t fixed_matrix<T, M, N>::rows()
+		{
+			return M;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr uint128_t fixed_matrix<T, M, N>::cols()
+		{
+			return N;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr T& fixed_matrix<T, M, N>::operator ()(uint128_t i, uint128_t j)
+		{
+			return base[i * N + j];
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr const T& fixed_matrix<T, M, N>::operator ()(uint128_t i, uint128_t j) const
+		{
+			return base[i * N + j];
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr T* fixed_matrix<T, M, N>::data()
+		{
+			return base;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr const T* fixed_matrix<T, M, N>::data() const
+		{
+			return base;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_vector<T, N> fixed_matrix<T, M, N>::row(uint128_t i) const
+		{
+			fixed_vector<T, N> result;
+			for (uint128_t j = 0; j < N; j++)
+				result.base[j] = base[i * N + j];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_vector<T, M> fixed_matrix<T, M, N>::col(uint128_t j) const
+		{
+			fixed_vector<T, M> result;
+			for (uint128_t i = 0; i < M; i++)
+				result.base[i] = base[i * N + j];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, N, M> fixed_matrix<T, M, N>::transposed() const
+		{
+			fixed_matrix<T, N, M> result;
+			for (uint128_t i = 0; i < M; i++)
+				for (uint128_t j = 0; j < N; j++)
+					result.base[j * M + i] = base[i * N + j];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr T fixed_matrix<T, M, N>::trace() const
+		{
+			T result = 0;
+			for (uint128_t i = 0; i < M && i < N; i++)
+				result += base[i * N + i];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr T fixed_matrix<T, M, N>::det() const
+		{
+			static_assert(M == N, "determinant is defined for square matrices only!");
+			const auto& a = *this;
+			if constexpr (N == 1)
+				return a(0, 0);
+			else if constexpr (N == 2)
+				return a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+			else if constexpr (N == 3)
+			{
+				return
+					  a(0, 0) * (a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1))
+					- a(0, 1) * (a(1, 0) * a(2, 2) - a(1, 2) * a(2, 0))
+					+ a(0, 2) * (a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0));
+			}
+			else if constexpr (N == 4)
+			{
+				// 2 x 2 minors of the top (s) and bottom (c) row pairs
+				T s0 = a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+				T s1 = a(0, 0) * a(1, 2) - a(0, 2) * a(1, 0);
+				T s2 = a(0, 0) * a(1, 3) - a(0, 3) * a(1, 0);
+				T s3 = a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1);
+				T s4 = a(0, 1) * a(1, 3) - a(0, 3) * a(1, 1);
+				T s5 = a(0, 2) * a(1, 3) - a(0, 3) * a(1, 2);
+				T c0 = a(2, 0) * a(3, 1) - a(2, 1) * a(3, 0);
+				T c1 = a(2, 0) * a(3, 2) - a(2, 2) * a(3, 0);
+				T c2 = a(2, 0) * a(3, 3) - a(2, 3) * a(3, 0);
+				T c3 = a(2, 1) * a(3, 2) - a(2, 2) * a(3, 1);
+				T c4 = a(2, 1) * a(3, 3) - a(2, 3) * a(3, 1);
+				T c5 = a(2, 2) * a(3, 3) - a(2, 3) * a(3, 2);
+				return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			}
+			else
+			{
+				// Gauss elimination with partial pivoting on a copy
+				fixed_matrix u(*this);
+				T result = 1;
+				for (uint128_t k = 0; k < N; k++)
+				{
+					uint128_t pivot = k;
+					for (uint128_t i = k + 1; i < N; i++)
+						if (kernel::magnitude(u(i, k)) > kernel::magnitude(u(pivot, k)))
+							pivot = i;
+					if (u(pivot, k) == T(0))
+						return T(0);
+					if (pivot != k)
+					{
+						for (uint128_t j = k; j < N; j++)
+						{
+							T t = u(k, j);
+							u(k, j) = u(pivot, j);
+							u(pivot, j) = t;
+						}
+						result = -result;
+					}
+					result *= u(k, k);
+					for (uint128_t i = k + 1; i < N; i++)
+					{
+						T factor = u(i, k) / u(k, k);
+						for (uint128_t j = k + 1; j < N; j++)
+							u(i, j) -= factor * u(k, j);
+					}
+				}
+				return result;
+			}
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::inversed() const
+		{
+			static_assert(M == N, "inverse is defined for square matrices only!");
+			const auto& a = *this;
+			fixed_matrix r;
+			if constexpr (N == 1)
+				r(0, 0) = T(1) / a(0, 0);
+			else if constexpr (N == 2)
+			{
+				T inv = T(1) / det();
+				r(0, 0) = a(1, 1) * inv;
+				r(0, 1) = -a(0, 1) * inv;
+				r(1, 0) = -a(1, 0) * inv;
+				r(1, 1) = a(0, 0) * inv;
+			}
+			else if constexpr (N == 3)
+			{
+				// adjugate: r(i, j) = cofactor(j, i) / det
+				T c00 = a(1, 1) * a(2, 2) - a(1, 2) * a(2, 1);
+				T c01 = a(1, 2) * a(2, 0) - a(1, 0) * a(2, 2);
+				T c02 = a(1, 0) * a(2, 1) - a(1, 1) * a(2, 0);
+				T inv = T(1) / (a(0, 0) * c00 + a(0, 1) * c01 + a(0, 2) * c02);
+				r(0, 0) = c00 * inv;
+				r(1, 0) = c01 * inv;
+				r(2, 0) = c02 * inv;
+				r(0, 1) = (a(0, 2) * a(2, 1) - a(0, 1) * a(2, 2)) * inv;
+				r(1, 1) = (a(0, 0) * a(2, 2) - a(0, 2) * a(2, 0)) * inv;
+				r(2, 1) = (a(0, 1) * a(2, 0) - a(0, 0) * a(2, 1)) * inv;
+				r(0, 2) = (a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1)) * inv;
+				r(1, 2) = (a(0, 2) * a(1, 0) - a(0, 0) * a(1, 2)) * inv;
+				r(2, 2) = (a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0)) * inv;
+			}
+			else if constexpr (N == 4)
+			{
+				T s0 = a(0, 0) * a(1, 1) - a(0, 1) * a(1, 0);
+				T s1 = a(0, 0) * a(1, 2) - a(0, 2) * a(1, 0);
+				T s2 = a(0, 0) * a(1, 3) - a(0, 3) * a(1, 0);
+				T s3 = a(0, 1) * a(1, 2) - a(0, 2) * a(1, 1);
+				T s4 = a(0, 1) * a(1, 3) - a(0, 3) * a(1, 1);
+				T s5 = a(0, 2) * a(1, 3) - a(0, 3) * a(1, 2);
+				T c0 = a(2, 0) * a(3, 1) - a(2, 1) * a(3, 0);
+				T c1 = a(2, 0) * a(3, 2) - a(2, 2) * a(3, 0);
+				T c2 = a(2, 0) * a(3, 3) - a(2, 3) * a(3, 0);
+				T c3 = a(2, 1) * a(3, 2) - a(2, 2) * a(3, 1);
+				T c4 = a(2, 1) * a(3, 3) - a(2, 3) * a(3, 1);
+				T c5 = a(2, 2) * a(3, 3) - a(2, 3) * a(3, 2);
+				T inv = T(1) / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+				r(0, 0) = ( a(1, 1) * c5 - a(1, 2) * c4 + a(1, 3) * c3) * inv;
+				r(0, 1) = (-a(0, 1) * c5 + a(0, 2) * c4 - a(0, 3) * c3) * inv;
+				r(0, 2) = ( a(3, 1) * s5 - a(3, 2) * s4 + a(3, 3) * s3) * inv;
+				r(0, 3) = (-a(2, 1) * s5 + a(2, 2) * s4 - a(2, 3) * s3) * inv;
+				r(1, 0) = (-a(1, 0) * c5 + a(1, 2) * c2 - a(1, 3) * c1) * inv;
+				r(1, 1) = ( a(0, 0) * c5 - a(0, 2) * c2 + a(0, 3) * c1) * inv;
+				r(1, 2) = (-a(3, 0) * s5 + a(3, 2) * s2 - a(3, 3) * s1) * inv;
+				r(1, 3) = ( a(2, 0) * s5 - a(2, 2) * s2 + a(2, 3) * s1) * inv;
+				r(2, 0) = ( a(1, 0) * c4 - a(1, 1) * c2 + a(1, 3) * c0) * inv;
+				r(2, 1) = (-a(0, 0) * c4 + a(0, 1) * c2 - a(0, 3) * c0) * inv;
+				r(2, 2) = ( a(3, 0) * s4 - a(3, 1) * s2 + a(3, 3) * s0) * inv;
+				r(2, 3) = (-a(2, 0) * s4 + a(2, 1) * s2 - a(2, 3) * s0) * inv;
+				r(3, 0) = (-a(1, 0) * c3 + a(1, 1) * c1 - a(1, 2) * c0) * inv;
+				r(3, 1) = ( a(0, 0) * c3 - a(0, 1) * c1 + a(0, 2) * c0) * inv;
+				r(3, 2) = (-a(3, 0) * s3 + a(3, 1) * s1 - a(3, 2) * s0) * inv;
+				r(3, 3) = ( a(2, 0) * s3 - a(2, 1) * s1 + a(2, 2) * s0) * inv;
+			}
+			else
+			{
+				// Gauss-Jordan with partial pivoting: [A | E] -> [E | A^-1]
+				fixed_matrix u(*this);
+				r = identity();
+				for (uint128_t k = 0; k < N; k++)
+				{
+					uint128_t pivot = k;
+					for (uint128_t i = k + 1; i < N; i++)
+						if (kernel::magnitude(u(i, k)) > kernel::magnitude(u(pivot, k)))
+							pivot = i;
+					assert(u(pivot, k) != T(0) && "matrix is singular");
+					for (uint128_t j = 0; j < N; j++)
+					{
+						T t = u(k, j);
+						u(k, j) = u(pivot, j);
+						u(pivot, j) = t;
+						t = r(k, j);
+						r(k, j) = r(pivot, j);
+						r(pivot, j) = t;
+					}
+
+					T inv = T(1) / u(k, k);
+					for (uint128_t j = 0; j < N; j++)
+					{
+						u(k, j) *= inv;
+						r(k, j) *= inv;
+					}
+					for (uint128_t i = 0; i < N; i++)
+					{
+						if (i == k)
+							continue;
+						T factor = u(i, k);
+						for (uint128_t j = 0; j < N; j++)
+						{
+							u(i, j) -= factor * u(k, j);
+							r(i, j) -= factor * r(k, j);
+						}
+					}
+				}
+			}
+			return r;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::operator -() const
+		{
+			fixed_matrix result;
+			for (uint128_t i = 0; i < M * N; i++)
+				result.base[i] = -base[i];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>& fixed_matrix<T, M, N>::operator +=(const fixed_matrix& oth)
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				base[i] += oth.base[i];
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>& fixed_matrix<T, M, N>::operator -=(const fixed_matrix& oth)
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				base[i] -= oth.base[i];
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>& fixed_matrix<T, M, N>::operator *=(const T& value)
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				base[i] *= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N>& fixed_matrix<T, M, N>::operator /=(const T& value)
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				base[i] /= value;
+			return *this;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::operator +(const fixed_matrix& oth) const
+		{
+			fixed_matrix result(*this);
+			return result += oth;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::operator -(const fixed_matrix& oth) const
+		{
+			fixed_matrix result(*this);
+			return result -= oth;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::operator *(const T& value) const
+		{
+			fixed_matrix result(*this);
+			return result *= value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> fixed_matrix<T, M, N>::operator /(const T& value) const
+		{
+			fixed_matrix result(*this);
+			return result /= value;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		template<uint128_t K>
+		constexpr fixed_matrix<T, M, K> fixed_matrix<T, M, N>::operator *(const fixed_matrix<T, N, K>& oth) const
+		{
+			fixed_matrix<T, M, K> result;
+			for (uint128_t i = 0; i < M; i++)
+				for (uint128_t k = 0; k < N; k++)
+				{
+					T a = base[i * N + k];
+					for (uint128_t j = 0; j < K; j++)
+						result.base[i * K + j] += a * oth.base[k * K + j];
+				}
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_vector<T, M> fixed_matrix<T, M, N>::operator *(const fixed_vector<T, N>& vect) const
+		{
+			fixed_vector<T, M> result;
+			for (uint128_t i = 0; i < M; i++)
+				for (uint128_t j = 0; j < N; j++)
+					result.base[i] += base[i * N + j] * vect.base[j];
+			return result;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr bool fixed_matrix<T, M, N>::operator ==(const fixed_matrix& oth) const
+		{
+			for (uint128_t i = 0; i < M * N; i++)
+				if (base[i] != oth.base[i])
+					return false;
+			return true;
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr bool fixed_matrix<T, M, N>::operator !=(const fixed_matrix& oth) const
+		{
+			return !(*this == oth);
+		}
+
+		template<typename T, uint128_t M, uint128_t N>
+		constexpr fixed_matrix<T, M, N> operator *(const T& value, const fixed_matrix<T, M, N>& matr)
+		{
+			return matr * value;
+		}
+	}
+}
@@ -0,0 +1,253 @@
+#include "../include/gemm.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// copies mc x kc block of A into MR-row panels, panel element (r, p) is at [p * MR + r]
+		template<typename T>
+		inline void gemm_pack_a(uint128_t mc, uint128_t kc, const T* a, uint128_t lda, T* buffer)
+		{
+			constexpr auto MR = gemm_block<T>::MR;
+			for (uint128_t i = 0; i < mc; i += MR)
+			{
+				auto mr = std::min(MR, mc - i);
+				for (uint128_t p = 0; p < kc; p++)
+				{
+					for (uint128_t r = 0; r < mr; r++)
+						buffer[r] = a[(i + r) * lda + p];
+					for (uint128_t r = mr; r < MR; r++)
+						buffer[r] = T(0);
+					buffer += MR;
+				}
+			}
+		}
+
+		// copies kc x nc block of B into NR-column panels, panel element (p, c) is at [p * NR + c]
+		template<typename T>
+		inline void gemm_pack_b(uint128_t kc, uint128_t nc, const T* b, uint128_t ldb, T* buffer)
+		{
+			constexpr auto NR = gemm_block<T>::NR;
+			for (uint128_t j = 0; j < nc; j += NR)
+			{
+				auto nr = std::min(NR, nc - j);
+				for (uint128_t p = 0; p < kc; p++)
+				{
+					const T* row = b + p * ldb + j;
+					for (uint128_t c = 0; c < nr; c++)
+						buffer[c] = row[c];
+					for (uint128_t c = nr; c < NR; c++)
+						buffer[c] = T(0);
+					buffer += NR;
+				}
+			}
+		}
+
+		// C[mr x nr] += alpha * A_panel * B_panel, accumulator is kept in registers
+		template<typename T>
+		inline void gemm_micro_kernel(uint128_t kc, const T& alpha, const T* pa, const T* pb,
+			T* c, uint128_t ldc, uint128_t mr, uint128_t nr)
+		{
+			constexpr auto MR = gemm_block<T>::MR;
+			constexpr auto NR = gemm_block<T>::NR;
+
+			T acc[MR][NR] = {};
+			for (uint128_t p = 0; p < kc; p++)
+			{
+				for (uint128_t r = 0; r < MR; r++)
+				{
+					T ar = pa[r];
+					for (uint128_t s = 0; s < NR; s++)
+						acc[r][s] += ar * pb[s];
+				}
+				pa += MR;
+				pb += NR;
+			}
+
+			for (uint128_t r = 0; r < mr; r++)
+				for (uint128_t s = 0; s < nr; s++)
+					c[r * ldc + s] += alpha * acc[r][s];
+		}
+
+		template<typename T>
+		inline void gemm_scale(uint128_t m, uint128_t n, const T& beta, T* c, uint128_t ldc)
+		{
+			if (beta == T(1))
+				return;
+			for (uint128_t i = 0; i < m; i++)
+				for (uint128_t j = 0; j < n; j++)
+					c[i * ldc + j] = beta == T(0) ? T(0) : c[i * ldc + j] * beta;
+		}
+
+		template<typename T>
+		inline void gemm_small(uint128_t m, uint128_t n, uint128_t k,
+			const T& alpha, const T* a, uint128_t lda, const T* b, uint128_t ldb, T* c, uint128_t ldc)
+		{
+			for (uint128_t i = 0; i < m; i++)
+			{
+				T* crow = c + i * ldc;
+				for (uint128_t p = 0; p < k; p++)
+				{
+					T aip = alpha * a[i * lda + p];
+					const T* brow = b + p * ldb;
+					for (uint128_t j = 0; j < n; j++)
+						crow[j] += aip * brow[j];
+				}
+			}
+		}
+
+		// y += alpha * x
+		template<typename T>
+		inline void row_axpy(uint128_t n, const T& alpha, const T* x, T* y)
+		{
+			for (uint128_t i = 0; i < n; i++)
+				y[i] += alpha * x[i];
+		}
+
+		template<typename T>
+		inline T row_dot(uint128_t n, const T* x, const T* y)
+		{
+			if constexpr (typing::is_simd_v<T>)
+				return simd::dot(x, y, n);
+
+			T result = 0;
+			for (uint128_t i = 0; i < n; i++)
+				result += x[i] * y[i];
+			return result;
+		}
+
+		template<typename T>
+		inline void gemm(uint128_t m, uint128_t n, uint128_t k,
+			const T& alpha, const T* a, uint128_t lda, const T* b, uint128_t ldb,
+			const T& beta, T* c, uint128_t ldc)
+		{
+			using block = gemm_block<T>;
+
+			gemm_scale(m, n, beta, c, ldc);
+			if (m == 0 || n == 0 || k == 0)
+				return;
+
+			if (m * n * k <= GEMM_SMALL_SIZE)
+			{
+				gemm_small(m, n, k, alpha, a, lda, b, ldb, c, ldc);
+				return;
+			}
+
+			// row blocks of C are split between threads, each thread packs its own A;
+			// blocks are made smaller than MC if there are not enough of them
+			uint128_t nthreads = m * n * k >= parallel::serial_cutoff() && !parallel::inside_task ? parallel::threads() : 1;
+			auto mcstep = std::min(block::MC, ((m + nthreads - 1) / nthreads + block::MR - 1) / block::MR * block::MR);
+			auto nblocks = (m + mcstep - 1) / mcstep;
+
+			auto kcmax = std::min(block::KC, k);
+			auto ncmax = std::min(block::NC, n);
+			std::vector<T> bpack(kcmax * ((ncmax + block::NR - 1) / block::NR) * block::NR);
+
+			for (uint128_t jc = 0; jc < n; jc += block::NC)
+			{
+				auto nc = std::min(block::NC, n - jc);
+				auto npanels = (nc + block::NR - 1) / block::NR;
+				for (uint128_t pc = 0; pc < k; pc += block::KC)
+				{
+					auto kc = std::min(block::KC, k - pc);
+
+					// panels of B are independent, so they are packed in parallel too
+					parallel::parallel_for(0, npanels, m * nc * kc, [&](uint128_t lo, uint128_t hi)
+					{
+						auto j = lo * block::NR;
+						gemm_pack_b(kc, std::min(hi * block::NR, nc) - j, b + pc * ldb + jc + j, ldb, bpack.data() + j * kc);
+					});
+
+					parallel::parallel_for(0, nblocks, m * nc * kc, [&](uint128_t lo, uint128_t hi)
+					{
+						std::vector<T> apack(kc * mcstep);
+						for (uint128_t blk = lo; blk < hi; blk++)
+						{
+							auto ic = blk * mcstep;
+							auto mc = std::min(mcstep, m - ic);
+							gemm_pack_a(mc, kc, a + ic * lda + pc, lda, apack.data());
+
+							for (uint128_t jr = 0; jr < nc; jr += block::NR)
+							{
+								auto nr = std::min(block::NR, nc - jr);
+								const T* pb = bpack.data() + jr * kc;
+								for (uint128_t ir = 0; ir < mc; ir += block::MR)
+								{
+									auto mr = std::min(block::MR, mc - ir);
+									const T* pa = apack.data() + ir * kc;
+									gemm_micro_kernel(kc, alpha, pa, pb, c + (ic + ir) * ldc + jc + jr, ldc, mr, nr);
+								}
+							}
+						}
+					});
+				}
+			}
+		}
+
+		template<typename T>
+		inline void trsv(bool lower, bool unit, uint128_t n, const T* a, uint128_t lda, T* x)
+		{
+			if (lower)
+			{
+				for (uint128_t i = 0; i < n; i++)
+				{
+					x[i] -= row_dot(i, a + i * lda, x);
+					if (!unit)
+						x[i] /= a[i * lda + i];
+				}
+			}
+			else
+			{
+				for (uint128_t i = n; i-- > 0;)
+				{
+					x[i] -= row_dot(n - i - 1, a + i * lda + i + 1, x + i + 1);
+					if (!unit)
+						x[i] /= a[i * lda + i];
+				}
+			}
+		}
+
+		template<typename T>
+		inline void trsm(bool lower, bool unit, uint128_t n, uint128_t k, const T* a, uint128_t lda, T* b, uint128_t ldb)
+		{
+			// row i of the diagonal block is solved by axpy of the rows above (or below)
+			auto solve_row = [&](uint128_t i, uint128_t beg, uint128_t end)
+			{
+				T* row = b + i * ldb;
+				for (uint128_t r = beg; r < end; r++)
+					row_axpy(k, -a[i * lda + r], b + r * ldb, row);
+				if (!unit)
+				{
+					T pivot = T(1) / a[i * lda + i];
+					for (uint128_t j = 0; j < k; j++)
+						row[j] *= pivot;
+				}
+			};
+
+			if (lower)
+			{
+				for (uint128_t ib = 0; ib < n; ib += TRSM_BLOCK_SIZE)
+				{
+					auto ie = std::min(ib + TRSM_BLOCK_SIZE, n);
+					for (uint128_t i = ib; i < ie; i++)
+						solve_row(i, ib, i);
+
+					if (ie < n)
+						gemm<T>(n - ie, k, ie - ib, T(-1), a + ie * lda + ib, lda, b + ib * ldb, ldb, T(1), b + ie * ldb, ldb);
+				}
+			}
+			else
+			{
+				for (uint128_t ie = n, ib; ie > 0; ie = ib)
+				{
+					ib = ie > TRSM_BLOCK_SIZE ? ie - TRSM_BLOCK_SIZE : 0;
+					for (uint128_t i = ie; i-- > ib;)
+						solve_row(i, i + 1, ie);
+
+					if (ib > 0)
+						gemm<T>(ib, k, ie - ib, T(-1), a + ib, lda, b + ib * ldb, ldb, T(1), b, ldb);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,448 @@
+#include "../include/iterative.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// x^H y
+		template<typename T>
+		inline T inner(uint128_t n, const T* x, const T* y)
+		{
+			if constexpr (typing::is_floating_point<T>::value)
+				return row_dot(n, x, y);
+
+			T result = 0;
+			for (uint128_t i = 0; i < n; i++)
+				result += nm::conj(x[i]) * y[i];
+			return result;
+		}
+
+		template<typename T>
+		inline typing::real_type_t<T> norm(uint128_t n, const T* x)
+		{
+			return std::sqrt(nm::real(inner(n, x, x)));
+		}
+
+		// complex Givens rotation [c s; -conj(s) c] which zeroes b in (a, b), c is real
+		template<typename T>
+		inline void givens(const T& a, const T& b, T& c, T& s)
+		{
+			auto na = nm::abs(a);
+			auto nb = nm::abs(b);
+			if (nb == 0)
+			{
+				c = 1;
+				s = 0;
+				return;
+			}
+			if (na == 0)
+			{
+				c = 0;
+				s = nm::conj(b) / T(nb);
+				return;
+			}
+			auto r = std::sqrt(na * na + nb * nb);
+			c = na / r;
+			s = a / T(na) * nm::conj(b) / T(r);
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline linear_operator<T>::linear_operator(uint128_t n, function_t matvec) :
+			n(n),
+			matvec(std::move(matvec))
+		{
+		}
+
+		template<typename T>
+		inline linear_operator<T>::linear_operator(const matrix_base<T>& matr) :
+			n(matr.rows())
+		{
+			assert(matr.is_square());
+			const matrix_base<T>* a = &matr;
+			matvec = [a](const vector_base<T>& x, vector_base<T>& y)
+			{
+				auto n = a->rows();
+				parallel::parallel_for(0, n, n * n, [&](uint128_t lo, uint128_t hi)
+				{
+					for (auto i = lo; i < hi; i++)
+						y.base[i] = kernel::row_dot(n, a->data() + i * a->ld, x.base.data());
+				});
+			};
+		}
+
+		template<typename T>
+		inline linear_operator<T>::linear_operator(const sparse_matrix<T>& matr) :
+			n(matr.rows())
+		{
+			assert(matr.rows() == matr.cols());
+			const sparse_matrix<T>* a = &matr;
+			matvec = [a](const vector_base<T>& x, vector_base<T>& y)
+			{
+				if (a->format() == sparse_format_t::csr)
+					kernel::sparse_gather(a->rows(), a->offsets.data(), a->indices.data(), a->values.data(), x.base.data(), y.base.data());
+				else
+					y.base = kernel::sparse_scatter<T>(a->cols(), a->rows(), a->offsets.data(), a->indices.data(), a->values.data(), x.base.data());
+			};
+		}
+
+		template<typename T>
+		inline linear_operator<T>::linear_operator(const band_matrix<T>& matr) :
+			n(matr.rows())
+		{
+			const band_matrix<T>* a = &matr;
+			matvec = [a](const vector_base<T>& x, vector_base<T>& y)
+			{
+				kernel::band_gemv(a->rows(), a->kl, a->ku, a->band.data(), a->band.ld, x.base.data(), y.base.data());
+			};
+		}
+
+		template<typename T>
+		inline uint128_t linear_operator<T>::rows() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline uint128_t linear_operator<T>::cols() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline void linear_operator<T>::apply(const vector_base<T>& x, vector_base<T>& y) const
+		{
+			assert(x.size() == n && y.size() == n);
+			matvec(x, y);
+		}
+
+		template<typename T>
+		inline krylov_base<T>::krylov_base(real_t tolerance, uint128_t max_iterations, uint128_t restart) :
+			tolerance(tolerance),
+			max_iterations(max_iterations),
+			restart(restart),
+			success(false),
+			count(0)
+		{
+		}
+
+		template<typename T>
+		inline bool krylov_base<T>::converged() const
+		{
+			return success;
+		}
+
+		template<typename T>
+		inline uint128_t krylov_base<T>::iterations() const
+		{
+			return count;
+		}
+
+		template<typename T>
+		inline typename krylov_base<T>::real_t krylov_base<T>::residual() const
+		{
+			return residuals.empty() ? real_t(0) : residuals.back();
+		}
+
+		template<typename T>
+		inline const std::vector<typename krylov_base<T>::real_t>& krylov_base<T>::history() const
+		{
+			return residuals;
+		}
+
+		template<typename T>
+		inline void krylov_base<T>::prepare(uint128_t n, uint128_t vectors, vector_base<T>& x)
+		{
+			if (work.size() < vectors)
+				work.resize(vectors);
+			for (uint128_t i = 0; i < vectors; i++)
+				if (work[i].size() != n)
+					work[i] = vector_base<T>(n);
+			if (x.size() != n)
+				x = vector_base<T>(n);
+
+			success = false;
+			count = 0;
+			residuals.clear();
+		}
+
+		template<typename T>
+		inline bool krylov_base<T>::record(real_t value)
+		{
+			residuals.push_back(value);
+			success = value <= tolerance;
+			return success;
+		}
+
+		template<typename T>
+		inline bool krylov_base<T>::cg(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x)
+		{
+			auto n = matr.rows();
+			assert(b.size() == n);
+			prepare(n, 3, x);
+
+			auto& r = work[0];
+			auto& p = work[1];
+			auto& q = work[2];
+			T* xp = x.base.data();
+			T* rp = r.base.data();
+			T* pp = p.base.data();
+			T* qp = q.base.data();
+
+			auto bnorm = kernel::norm(n, b.base.data());
+			if (bnorm == 0)
+				bnorm = 1;
+
+			// r = b - A x, p = r
+			matr.apply(x, r);
+			for (uint128_t i = 0; i < n; i++)
+				rp[i] = b.base[i] - rp[i];
+			std::copy_n(rp, n, pp);
+
+			T rho = kernel::inner(n, rp, rp);
+			if (record(std::sqrt(nm::real(rho)) / bnorm))
+				return true;
+
+			while (count < max_iterations)
+			{
+				matr.apply(p, q);
+				T pq = kernel::inner(n, pp, qp);
+				if (pq == T(0))
+					break;
+
+				T alpha = rho / pq;
+				kernel::row_axpy(n, alpha, pp, xp);
+				kernel::row_axpy(n, -alpha, qp, rp);
+				count++;
+
+				T rho_next = kernel::inner(n, rp, rp);
+				if (record(std::sqrt(nm::real(rho_next)) / bnorm))
+					break;
+
+				// p = r + beta p
+				T beta = rho_next / rho;
+				for (uint128_t i = 0; i < n; i++)
+					pp[i] = rp[i] + beta * pp[i];
+				rho = rho_next;
+			}
+			return success;
+		}
+
+		template<typename T>
+		inline bool krylov_base<T>::bicgstab(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x)
+		{
+			auto n = matr.rows();
+			assert(b.size() == n);
+			prepare(n, 6, x);
+
+			auto& r = work[0];
+			auto& rhat = work[1];
+			auto& p = work[2];
+			auto& v = work[3];
+			auto& s = work[4];
+			auto& t = work[5];
+			T* xp = x.base.data();
+			T* rp = r.base.data();
+			T* hp = rhat.base.data();
+			T* pp = p.base.data();
+			T* vp = v.base.data();
+			T* sp = s.base.data();
+			T* tp = t.base.data();
+
+			auto bnorm = kernel::norm(n, b.base.data());
+			if (bnorm == 0)
+				bnorm = 1;
+
+			matr.apply(x, r);
+			for (uint128_t i = 0; i < n; i++)
+				rp[i] = b.base[i] - rp[i];
+			std::copy_n(rp, n, hp);
+			std::fill_n(pp, n, T(0));
+			std::fill_n(vp, n, T(0));
+
+			if (record(kernel::norm(n, rp) / bnorm))
+				return true;
+
+			T rho = 1, alpha = 1, omega = 1;
+			while (count < max_iterations)
+			{
+				T rho_next = kernel::inner(n, hp, rp);
+				if (rho_next == T(0))
+					break;
+
+				// p = r + beta (p - omega v)
+				T beta = rho_next / rho * (alpha / omega);
+				for (uint128_t i = 0; i < n; i++)
+					pp[i] = rp[i] + beta * (pp[i] - omega * vp[i]);
+
+				matr.apply(p, v);
+				T hv = kernel::inner(n, hp, vp);
+				if (hv == T(0))
+					break;
+				alpha = rho_next / hv;
+				count++;
+
+				// s = r - alpha v
+				for (uint128_t i = 0; i < n; i++)
+					sp[i] = rp[i] - alpha * vp[i];
+				auto snorm = kernel::norm(n, sp) / bnorm;
+				if (snorm <= tolerance)
+				{
+					kernel::row_axpy(n, alpha, pp, xp);
+					record(snorm);
+					break;
+				}
+
+				matr.apply(s, t);
+				auto tt = nm::real(kernel::inner(n, tp, tp));
+				if (tt == 0)
+					break;
+				omega = kernel::inner(n, tp, sp) / T(tt);
+
+				// x += alpha p + omega s, r = s - omega t
+				for (uint128_t i = 0; i < n; i++)
+				{
+					xp[i] += alpha * pp[i] + omega * sp[i];
+					rp[i] = sp[i] - omega * tp[i];
+				}
+				rho = rho_next;
+
+				if (record(kernel::norm(n, rp) / bnorm) || omega == T(0))
+					break;
+			}
+			return success;
+		}
+
+		template<typename T>
+		inline bool krylov_base<T>::gmres(const linear_operator<T>& matr, const vector_base<T>& b, vector_base<T>& x)
+		{
+			auto n = matr.rows();
+			auto m = std::max<uint128_t>(std::min(restart, n), 1);
+			assert(b.size() == n);
+
+			// work[0] is r and w, work[1 .. m + 1] is the Krylov basis
+			prepare(n, m + 2, x);
+			if (hessenberg.rows() != m + 1 || hessenberg.cols() != m)
+				hessenberg = matrix_base<T>(m + 1, m);
+			rotation_c.resize(m);
+			rotation_s.resize(m);
+			g.resize(m + 1);
+
+			auto& w = work[0];
+			T* wp = w.base.data();
+			T* xp = x.base.data();
+			auto& h = hessenberg;
+
+			auto bnorm = kernel::norm(n, b.base.data());
+			if (bnorm == 0)
+				bnorm = 1;
+
+			bool first = true;
+			while (true)
+			{
+				// r = b - A x, v_0 = r / |r|
+				matr.apply(x, w);
+				for (uint128_t i = 0; i < n; i++)
+					wp[i] = b.base[i] - wp[i];
+				auto beta = kernel::norm(n, wp);
+				if (first)
+				{
+					first = false;
+					if (record(beta / bnorm))
+						return true;
+				}
+				if (beta == 0 || count >= max_iterations)
+					break;
+
+				T* v0 = work[1].base.data();
+				for (uint128_t i = 0; i < n; i++)
+					v0[i] = wp[i] / T(beta);
+				std::fill(g.begin(), g.end(), T(0));
+				g[0] = beta;
+
+				uint128_t k = 0;
+				while (k < m && count < max_iterations)
+				{
+					auto j = k++;
+					count++;
+
+					// Arnoldi step, modified Gram-Schmidt
+					matr.apply(work[j + 1], w);
+					for (uint128_t i = 0; i <= j; i++)
+					{
+						const T* vi = work[i + 1].base.data();
+						h(i, j) = kernel::inner(n, vi, wp);
+						kernel::row_axpy(n, -h(i, j), vi, wp);
+					}
+					auto hnext = kernel::norm(n, wp);
+					h(j + 1, j) = hnext;
+					if (hnext != 0)
+					{
+						T* vn = work[j + 2].base.data();
+						for (uint128_t i = 0; i < n; i++)
+							vn[i] = wp[i] / T(hnext);
+					}
+
+					// previous rotations, then the new one zeroes h(j + 1, j)
+					for (uint128_t i = 0; i < j; i++)
+					{
+						T hi = h(i, j);
+						T hn = h(i + 1, j);
+						h(i, j) = rotation_c[i] * hi + rotation_s[i] * hn;
+						h(i + 1, j) = -nm::conj(rotation_s[i]) * hi + rotation_c[i] * hn;
+					}
+					kernel::givens(h(j, j), h(j + 1, j), rotation_c[j], rotation_s[j]);
+					h(j, j) = rotation_c[j] * h(j, j) + rotation_s[j] * h(j + 1, j);
+					h(j + 1, j) = 0;
+					g[j + 1] = -nm::conj(rotation_s[j]) * g[j];
+					g[j] = rotation_c[j] * g[j];
+
+					// |g[j + 1]| is the residual of the least squares solution, no product is needed
+					if (record(nm::abs(g[j + 1]) / bnorm) || hnext == 0)
+						break;
+				}
+
+				// y = H^-1 g, x += V y
+				for (uint128_t i = k; i-- > 0;)
+				{
+					T sum = g[i];
+					for (uint128_t c = i + 1; c < k; c++)
+						sum -= h(i, c) * g[c];
+					g[i] = sum / h(i, i);
+				}
+				for (uint128_t i = 0; i < k; i++)
+					kernel::row_axpy(n, g[i], work[i + 1].base.data(), xp);
+
+				if (success || count >= max_iterations)
+					break;
+			}
+			return success;
+		}
+	}
+
+	template<typename M, typename T>
+	inline base_type::vector_base<T> cg(const M& matr, const base_type::vector_base<T>& b, typing::real_type_t<T> tolerance)
+	{
+		base_type::vector_base<T> x(b.size());
+		base_type::krylov_base<T>(tolerance).cg(base_type::linear_operator<T>(matr), b, x);
+		return x;
+	}
+
+	template<typename M, typename T>
+	inline base_type::vector_base<T> bicgstab(const M& matr, const base_type::vector_base<T>& b, typing::real_type_t<T> tolerance)
+	{
+		base_type::vector_base<T> x(b.size());
+		base_type::krylov_base<T>(tolerance).bicgstab(base_type::linear_operator<T>(matr), b, x);
+		return x;
+	}
+
+	template<typename M, typename T>
+	inline base_type::vector_base<T> gmres(const M& matr, const base_type::vector_base<T>& b, typing::real_type_t<T> tolerance, uint128_t restart)
+	{
+		base_type::vector_base<T> x(b.size());
+		base_type::krylov_base<T>(tolerance, 1000, restart).gmres(base_type::linear_operator<T>(matr), b, x);
+		return x;
+	}
+}
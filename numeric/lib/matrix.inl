@@ -7,79 +7,151 @@ namespace nm
 	{
 		template<typename T>
 		inline matrix_base<T>::matrix_base(uint128_t mn) :
-			base(mn, vector_base<T>(mn))
+			base(mn * mn),
+			nrows(mn),
+			ncols(mn),
+			ld(mn)
 		{
 		}
 
 		template<typename T>
 		inline matrix_base<T>::matrix_base(uint128_t m, uint128_t n) :
-			base(m, vector_base<T>(n))
+			base(m * n),
+			nrows(m),
+			ncols(n),
+			ld(n)
 		{
 		}
 
 		template<typename T>
 		inline matrix_base<T>::matrix_base(uint128_t m, uint128_t n, T value) :
-			base(m, vector_base<T>(n, value))
+			base(m * n, value),
+			nrows(m),
+			ncols(n),
+			ld(n)
 		{
 		}
 
 		template<typename T>
-		inline matrix_base<T>::matrix_base(const std::vector<std::vector<T>>& stdmatr)
+		inline matrix_base<T>::matrix_base(uint128_t m, uint128_t n, layout_t layout) :
+			nrows(m),
+			ncols(n),
+			ld(layout == layout_t::padded ? memory::padded_ld<T>(n) : n)
 		{
+			base.resize(nrows * ld);
+		}
+
+		template<typename T>
+		inline matrix_base<T>::matrix_base(const matrix_base& oth, layout_t layout) :
+			matrix_base(oth.nrows, oth.ncols, layout)
+		{
+			for (uint128_t i = 0; i < nrows; i++)
+				std::copy_n(oth.base.data() + i * oth.ld, ncols, base.data() + i * ld);
+		}
+
+		template<typename T>
+		inline matrix_base<T>::matrix_base(const std::vector<std::vector<T>>& stdmatr) :
+			nrows(stdmatr.size()),
+			ncols(stdmatr.empty() ? 0 : stdmatr.begin()->size()),
+			ld(ncols)
+		{
+			base.reserve(nrows * ld);
 			for (auto& vector : stdmatr)
-				base.push_back(vector);
+			{
+				assert(vector.size() == ncols);
+				base.insert(base.end(), vector.begin(), vector.end());
+			}
 		}
 
 		template<typename T>
-		inline matrix_base<T>::matrix_base(const std::initializer_list<std::initializer_list<T>>& rawmatr)
+		inline matrix_base<T>::matrix_base(const std::initializer_list<std::initializer_list<T>>& rawmatr) :
+			nrows(rawmatr.size()),
+			ncols(rawmatr.size() == 0 ? 0 : rawmatr.begin()->size()),
+			ld(ncols)
 		{
+			base.reserve(nrows * ld);
 			for (auto& vector : rawmatr)
-				base.push_back(vector);
+			{
+				assert(vector.size() == ncols);
+				base.insert(base.end(), vector.begin(), vector.end());
+			}
+		}
+
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline matrix_base<T>::matrix_base(const matrix_expr<L, R, Op>& expr) :
+			base(expr.rows() * expr.cols()),
+			nrows(expr.rows()),
+			ncols(expr.cols()),
+			ld(ncols)
+		{
+			for (int i = 0; i < nrows; i++)
+				for (int j = 0; j < ncols; j++)
+					base[i * ld + j] = expr(i, j);
+		}
+
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline matrix_base<T>& matrix_base<T>::operator=(const matrix_expr<L, R, Op>& expr)
+		{
+			if (size() != expr.size() || aliases(storage(*this), expr))
+				*this = matrix_base<T>(expr);
+			else
+				for (int i = 0; i < nrows; i++)
+					for (int j = 0; j < ncols; j++)
+						base[i * ld + j] = expr(i, j);
+			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::fill(T value)
 		{
-			for (auto& vect : base)
-				vect.fill(value);
+			if constexpr (typing::is_simd_v<T>)
+			{
+				if (!is_padded())
+				{
+					simd::fill(base.data(), value, base.size());
+					return *this;
+				}
+			}
+
+			for (uint128_t i = 0; i < nrows; i++)
+				std::fill_n(base.data() + i * ld, ncols, value);
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::fill_diagonal(T value, int32_t index)
 		{
-			auto n = rows() - std::abs(index);
-			auto beg = index < 0 ? 1 : 0;
+			auto beg = index < 0 ? -index : 0;
+			auto n = index < 0 ? std::min<int128_t>(rows() + index, cols()) : std::min<int128_t>(rows(), cols() - index);
 			for (int i = beg; i < n + beg; i++)
-				base[i][i + index] = value;
+				base[i * ld + i + index] = value;
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::fill_diagonal(vector_base<T> values, int32_t index)
 		{
-			auto m = rows();
-			auto n = m - std::abs(index);
+			auto beg = index < 0 ? -index : 0;
+			auto n = index < 0 ? std::min<int128_t>(rows() + index, cols()) : std::min<int128_t>(rows(), cols() - index);
 			assert(values.size() == n);
 
-			auto beg = index < 0 ? 1 : 0;
 			for (int i = beg; i < n + beg; i++)
-				base[i][i + index] = values[i - beg];
+				base[i * ld + i + index] = values[i - beg];
 			return *this;
 		}
 
 		template<typename T>
 		inline uint128_t matrix_base<T>::rows() const
 		{
-			return base.size();
+			return nrows;
 		}
 
 		template<typename T>
 		inline uint128_t matrix_base<T>::cols() const
 		{
-			if (base.empty())
-				return 0;
-			return base.front().size();
+			return ncols;
 		}
 
 		template<typename T>
@@ -89,70 +161,127 @@ namespace nm
 		}
 
 		template<typename T>
-		inline vector_base<T>& matrix_base<T>::row(int i)
+		inline T* matrix_base<T>::data()
 		{
-			if (i < 0)
-				return base[base.size() + i];
-			return base[i];
+			return base.data();
+		}
+
+		template<typename T>
+		inline const T* matrix_base<T>::data() const
+		{
+			return base.data();
+		}
+
+		template<typename T>
+		inline uint128_t matrix_base<T>::leading_dim() const
+		{
+			return ld;
 		}
 
 		template<typename T>
-		inline const vector_base<T>& matrix_base<T>::row(int i) const
+		inline layout_t matrix_base<T>::layout() const
+		{
+			return is_padded() ? layout_t::padded : layout_t::packed;
+		}
+
+		template<typename T>
+		inline bool matrix_base<T>::is_padded() const
+		{
+			return ld != ncols;
+		}
+
+		template<typename T>
+		inline bool matrix_base<T>::is_aligned() const
+		{
+			return memory::is_aligned(base.data()) && (ld * sizeof(T)) % memory::ALIGNMENT == 0;
+		}
+
+		template<typename T>
+		inline T& matrix_base<T>::operator()(uint128_t i, uint128_t j)
+		{
+			return base[i * ld + j];
+		}
+
+		template<typename T>
+		inline const T& matrix_base<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			return base[i * ld + j];
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_base<T>::row(int i)
 		{
 			if (i < 0)
-				return base[base.size() + i];
-			return base[i];
+				i = nrows + i;
+			return vector_view<T>(base.data() + i * ld, ncols);
 		}
 
 		template<typename T>
-		inline vector_base<T> matrix_base<T>::col(int i) const
+		inline vector_view<const T> matrix_base<T>::row(int i) const
 		{
-			auto [m, n] = size();
 			if (i < 0)
-				i = n + i;
+				i = nrows + i;
+			return vector_view<const T>(base.data() + i * ld, ncols);
+		}
 
-			vector_base<T> result(n);
-			for (int j = 0; j < m; j++)
-				result[j] = base[j][i];
-			return result;
+		template<typename T>
+		inline vector_view<T> matrix_base<T>::col(int i)
+		{
+			return view().col(i);
 		}
 
 		template<typename T>
-		inline vector_base<T> matrix_base<T>::diagonal(int i) const
+		inline vector_view<const T> matrix_base<T>::col(int i) const
 		{
-			auto n = rows() - std::abs(i);
-			vector_base<T> diag(n);
-			
-			auto beg = i < 0 ? 1 : 0;
-			for (int k = beg; k < n + beg; k++)
-				diag[k - beg] = base[k][k + i];
-			return diag;
+			return view().col(i);
 		}
 
 		template<typename T>
-		inline vector_base<T>& matrix_base<T>::operator[](int i)
+		inline vector_view<T> matrix_base<T>::diagonal(int i)
+		{
+			return view().diagonal(i);
+		}
+
+		template<typename T>
+		inline vector_view<const T> matrix_base<T>::diagonal(int i) const
+		{
+			return view().diagonal(i);
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_base<T>::operator[](int i)
 		{
 			return row(i);
 		}
 
 		template<typename T>
-		inline const vector_base<T>& matrix_base<T>::operator[](int i) const
+		inline vector_view<const T> matrix_base<T>::operator[](int i) const
 		{
 			return row(i);
 		}
 
 		template<typename T>
-		inline matrix_base<T> matrix_base<T>::slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, uint32_t rstep, uint32_t cstep)
+		inline matrix_view<T> matrix_base<T>::view()
 		{
-			int32_t rst = rstep;
-			auto m = 1 + std::abs(rend - rbeg) / rstep;
-			auto n = 1 + std::abs(cend - cbeg) / cstep;
-			if (rbeg > rend) rst = -rst;
+			return matrix_view<T>(base.data(), nrows, ncols, ld, 1);
+		}
 
-			matrix_base<T> result(m, n);
-			for (int i = 0; i < m; i++)
-				result[i] = (*this)[rbeg + i * rst].slice(cbeg, cend, cstep);
-			return result;
+		template<typename T>
+		inline matrix_view<const T> matrix_base<T>::view() const
+		{
+			return matrix_view<const T>(base.data(), nrows, ncols, ld, 1);
+		}
+
+		template<typename T>
+		inline matrix_view<T> matrix_base<T>::slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, uint32_t rstep, uint32_t cstep)
+		{
+			return view().slice(rbeg, rend, cbeg, cend, rstep, cstep);
+		}
+
+		template<typename T>
+		inline matrix_view<const T> matrix_base<T>::slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, uint32_t rstep, uint32_t cstep) const
+		{
+			return view().slice(rbeg, rend, cbeg, cend, rstep, cstep);
 		}
 
 		template<typename T>
@@ -160,10 +289,10 @@ namespace nm
 		{
 			auto m = rows();
 			uint128_t imax = 0;
-			auto vmax = base[imax].max();
+			auto vmax = *std::max_element(row(imax).begin(), row(imax).end());
 			for (int i = 1; i < m; i++)
 			{
-				auto cmax = base[i].max();
+				auto cmax = *std::max_element(row(i).begin(), row(i).end());
 				if (vmax < cmax)
 				{
 					imax = i;
@@ -178,10 +307,10 @@ namespace nm
 		{
 			auto m = rows();
 			uint128_t imin = 0;
-			auto vmin = base[imin].min();
+			auto vmin = *std::min_element(row(imin).begin(), row(imin).end());
 			for (int i = 1; i < m; i++)
 			{
-				auto cmin = base[i].min();
+				auto cmin = *std::min_element(row(i).begin(), row(i).end());
 				if (vmin > cmin)
 				{
 					imin = i;
@@ -196,14 +325,15 @@ namespace nm
 		{
 			auto m = rows();
 			uint128_t jmax = 0;
-			auto vmax = base[0][0];
+			auto vmax = base[0];
 			for (int i = 0; i < m; i++)
 			{
-				auto cmax = base[i].imax();
-				if (cmax != jmax && base[i][cmax] > vmax)
+				auto r = row(i);
+				auto cmax = std::distance(r.begin(), std::max_element(r.begin(), r.end()));
+				if (cmax != jmax && r[cmax] > vmax)
 				{
 					jmax = cmax;
-					vmax = base[i][cmax];
+					vmax = r[cmax];
 				}
 			}
 			return jmax;
@@ -214,14 +344,15 @@ namespace nm
 		{
 			auto m = rows();
 			uint128_t jmin = 0;
-			auto vmin = base[0][0];
+			auto vmin = base[0];
 			for (int i = 0; i < m; i++)
 			{
-				auto cmin = base[i].imin();
-				if (cmin != jmin && base[i][cmin] < vmin)
+				auto r = row(i);
+				auto cmin = std::distance(r.begin(), std::min_element(r.begin(), r.end()));
+				if (cmin != jmin && r[cmin] < vmin)
 				{
 					jmin = cmin;
-					vmin = base[i][cmin];
+					vmin = r[cmin];
 				}
 			}
 			return jmin;
@@ -243,9 +374,36 @@ namespace nm
 				for (int j = 0; j < m; j++)
 				{
 					if (i == j) continue;
-					if (base[i][j] != 0) 
+					if (base[i * ld + j] != 0) 
 						return false;
 				}
+			return true;
+		}
+
+		template<typename T>
+		inline bool matrix_base<T>::is_symmetric() const
+		{
+			if (!is_square()) return false;
+
+			auto m = rows();
+			for (int i = 0; i < m; i++)
+				for (int j = i + 1; j < m; j++)
+					if (base[i * ld + j] != base[j * ld + i])
+						return false;
+			return true;
+		}
+
+		template<typename T>
+		inline bool matrix_base<T>::is_hermitian() const
+		{
+			if (!is_square()) return false;
+
+			auto m = rows();
+			for (int i = 0; i < m; i++)
+				for (int j = i; j < m; j++)
+					if (base[i * ld + j] != nm::conj(base[j * ld + i]))
+						return false;
+			return true;
 		}
 
 		template<typename T>
@@ -262,7 +420,7 @@ namespace nm
 			auto m = rows();
 			for (int i = 0; i < m; i++)
 				for (int j = 0; j < i; j++)
-					if (base[i][j] != 0)
+					if (base[i * ld + j] != 0)
 						return false;
 
 			return true;
@@ -276,7 +434,7 @@ namespace nm
 			auto m = rows();
 			for (int i = 0; i < m; i++)
 				for (int j = i + 1; j < m; j++)
-					if (base[i][j] != 0)
+					if (base[i * ld + j] != 0)
 						return false;
 
 			return true;
@@ -285,7 +443,30 @@ namespace nm
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::transpose()
 		{
-			base = transposed().base;
+			auto [m, n] = size();
+			if (m == n)
+			{
+				kernel::transpose_square(n, data(), ld);
+				return *this;
+			}
+
+			// cycles need packed rows, the padding is restored after
+			bool padded = is_padded();
+			for (uint128_t i = 1; padded && i < m; i++)
+				std::copy_n(base.data() + i * ld, n, base.data() + i * n);
+			kernel::transpose_cycles(m, n, data());
+
+			nrows = n;
+			ncols = m;
+			ld = m;
+			if (padded)
+			{
+				auto pld = memory::padded_ld<T>(m);
+				base.resize(nrows * pld);
+				for (uint128_t i = nrows; i-- > 1;)
+					std::copy_backward(base.data() + i * m, base.data() + i * m + m, base.data() + i * pld + m);
+				ld = pld;
+			}
 			return *this;
 		}
 
@@ -293,17 +474,66 @@ namespace nm
 		inline matrix_base<T> matrix_base<T>::transposed() const
 		{
 			auto [m, n] = size();
-			matrix_base result(n, m);
-			for (int i = 0; i < n; i++)
-				for (int j = 0; j < m; j++)
-					result[i][j] = base[j][i];
+			matrix_base result(n, m, layout());
+			kernel::transpose(m, n, data(), ld, result.data(), result.ld);
 			return result;
 		}
 
 		template<typename T>
-		inline matrix_base<T> matrix_base<T>::inversed() const
+		inline matrix_base<T>& matrix_base<T>::inverse()
 		{
-			return adjugate() / det();
+			assert(is_square());
+			auto n = rows();
+			T* a = data();
+			std::vector<uint128_t> pivots(n);
+
+			// Gauss-Jordan with partial pivoting, inverse replaces the matrix
+			// column by column, row swaps are undone by column swaps at the end
+			for (uint128_t k = 0; k < n; k++)
+			{
+				auto p = k;
+				auto pmax = nm::abs(a[k * ld + k]);
+				for (uint128_t i = k + 1; i < n; i++)
+				{
+					auto value = nm::abs(a[i * ld + k]);
+					if (value > pmax)
+					{
+						p = i;
+						pmax = value;
+					}
+				}
+				assert(pmax != 0 && "matrix is singular");
+
+				pivots[k] = p;
+				if (p != k)
+					std::swap_ranges(a + k * ld, a + k * ld + n, a + p * ld);
+
+				T* pivot_row = a + k * ld;
+				T pivot = T(1) / pivot_row[k];
+				pivot_row[k] = 1;
+				for (uint128_t j = 0; j < n; j++)
+					pivot_row[j] *= pivot;
+
+				parallel::parallel_for(0, n, n * n, [&](uint128_t lo, uint128_t hi)
+				{
+					for (uint128_t i = lo; i < hi; i++)
+					{
+						if (i == k)
+							continue;
+						T* row = a + i * ld;
+						T factor = row[k];
+						row[k] = 0;
+						kernel::row_axpy(n, -factor, pivot_row, row);
+					}
+				});
+			}
+
+			for (uint128_t k = n; k-- > 0;)
+				if (pivots[k] != k)
+					for (uint128_t i = 0; i < n; i++)
+						std::swap(a[i * ld + k], a[i * ld + pivots[k]]);
+
+			return *this;
 		}
 
 		template<typename T>
@@ -326,11 +556,10 @@ namespace nm
 				typing::is_complex<T>::value,
 				"matrix must be complex!"
 			);
-			auto [m, n] = size();
-			matrix_base result(n, m);
-			for (int i = 0; i < n; i++)
-				for (int j = 0; j < m; j++)
-					result[i][j] = base[j][i].conjugate();
+			matrix_base result = transposed();
+			for (uint128_t i = 0; i < result.nrows; i++)
+				for (uint128_t j = 0; j < result.ncols; j++)
+					result.base[i * result.ld + j] = result.base[i * result.ld + j].conjugate();
 			return result;
 		}
 
@@ -341,15 +570,15 @@ namespace nm
 			switch (rows())
 			{
 			case 0:	return 0;
-			case 1:	return base[0][0];
-			case 2: return base[1][1] * base[0][0] - base[1][0] * base[0][1];
+			case 1:	return (*this)(0, 0);
+			case 2: return (*this)(1, 1) * (*this)(0, 0) - (*this)(1, 0) * (*this)(0, 1);
 			case 3: return 
-				  base[2][2] * base[1][1] * base[0][0]
-				- base[0][0] * base[1][2] * base[2][1] 
-				- base[0][1] * base[1][0] * base[2][2]
-				+ base[0][1] * base[1][2] * base[2][0] 
-				+ base[0][2] * base[1][0] * base[2][1]
-				- base[0][2] * base[1][1] * base[2][0];
+				  (*this)(2, 2) * (*this)(1, 1) * (*this)(0, 0)
+				- (*this)(0, 0) * (*this)(1, 2) * (*this)(2, 1) 
+				- (*this)(0, 1) * (*this)(1, 0) * (*this)(2, 2)
+				+ (*this)(0, 1) * (*this)(1, 2) * (*this)(2, 0) 
+				+ (*this)(0, 2) * (*this)(1, 0) * (*this)(2, 1)
+				- (*this)(0, 2) * (*this)(1, 1) * (*this)(2, 0);
 
 			default:
 				return gauss_determinant(*this);
@@ -379,23 +608,12 @@ namespace nm
 				for (int j = 0; j < n; j++)
 				{
 					if (j == jn) { joff = true; continue; };
-					matr[i - ioff][j - joff] = base[i][j];
+					matr(i - ioff, j - joff) = base[i * ld + j];
 				}
 			}
 			return matr.det();
 		}
 
-		template<typename T>
-		inline matrix_base<T> matrix_base<T>::operator-() const
-		{
-			auto [m, n] = size();
-			matrix_base<T> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = -base[i][j];
-			return result;
-		}
-
 		template<typename T>
 		template<typename V>
 		inline auto vector_base<T>::dot(const matrix_base<V>& mat) const
@@ -417,32 +635,6 @@ namespace nm
 			return (*this * vec);
 		}
 
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator+(const matrix_base<V>& oth) const
-		{
-			auto [m, n] = size();
-			assert(std::make_pair(m, n) == oth.size());
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] + oth[i][j];
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator-(const matrix_base<V>& oth) const
-		{
-			auto [m, n] = size();
-			assert(std::make_pair(m, n) == oth.size());
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] - oth[i][j];
-			return result;
-		}
-
 		template<typename T>
 		template<typename V>
 		inline auto matrix_base<T>::operator*(const matrix_base<V>& oth) const
@@ -452,16 +644,25 @@ namespace nm
 			assert(m == oth.rows());
 
 			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
-			matrix_base<TS> result(l, n);
-			for (int i = 0; i < l; i++)
-				for (int j = 0; j < n; j++)
-				{
-					TS sum = 0;
-					for (int k = 0; k < m; k++)
-						sum += base[i][k] * oth[k][j];
-					result[i][j] = sum;
-				}
+			matrix_base<TS> result(l, n, layout());
 
+			if constexpr (typing::is_same_v<T, V>)
+				kernel::gemm<TS>(l, n, m, 1, data(), ld, oth.data(), oth.ld, 0, result.data(), result.ld);
+			else
+			{
+				// operands are converted to the common type once, so the kernel works on one type
+				auto cast = [](const auto& matr)
+				{
+					matrix_base<TS> conv(matr.rows(), matr.cols());
+					for (int i = 0; i < matr.rows(); i++)
+						for (int j = 0; j < matr.cols(); j++)
+							conv(i, j) = matr(i, j);
+					return conv;
+				};
+				auto lhs = cast(*this);
+				auto rhs = cast(oth);
+				kernel::gemm<TS>(l, n, m, 1, lhs.data(), lhs.ld, rhs.data(), rhs.ld, 0, result.data(), result.ld);
+			}
 			return result;
 		}
 
@@ -474,200 +675,103 @@ namespace nm
 
 			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
 			vector_base<TS> result(m);
-			for (int i = 0; i < m; i++)
+			parallel::parallel_for(0, m, m * n, [&](uint128_t lo, uint128_t hi)
 			{
-				TS sum = 0;
-				for (int j = 0; j < n; j++)
-					sum += base[i][j] * vec[j];
-				result[i] = sum;
-			}
+				for (auto i = lo; i < hi; i++)
+				{
+					if constexpr (typing::is_simd_v<T> && typing::is_same_v<T, V>)
+						result.base[i] = simd::dot(base.data() + i * ld, vec.base.data(), n);
+					else
+					{
+						TS sum = 0;
+						for (uint128_t j = 0; j < n; j++)
+							sum += base[i * ld + j] * vec.base[j];
+						result.base[i] = sum;
+					}
+				}
+			});
 			return result;
 		}
 
 		template<typename T>
-		inline matrix_base<T>& matrix_base<T>::operator+=(const matrix_base<T>& oth)
+		template<typename E, typing::require<typing::is_matrix_operand_v<E>>>
+		inline matrix_base<T>& matrix_base<T>::operator+=(const E& oth)
 		{
 			auto [m, n] = size();
 			assert(std::make_pair(m, n) == oth.size());
+			if (aliases(storage(*this), oth))
+				return *this += owning(oth);
 			for (int i = 0; i < m; i++)
 				for (int j = 0; j < n; j++)
-					base[i][j] += oth[i][j];
+					base[i * ld + j] += oth(i, j);
 			return *this;
 		}
 
 		template<typename T>
-		inline matrix_base<T>& matrix_base<T>::operator-=(const matrix_base<T>& oth)
+		template<typename E, typing::require<typing::is_matrix_operand_v<E>>>
+		inline matrix_base<T>& matrix_base<T>::operator-=(const E& oth)
 		{
 			auto [m, n] = size();
 			assert(std::make_pair(m, n) == oth.size());
+			if (aliases(storage(*this), oth))
+				return *this -= owning(oth);
 			for (int i = 0; i < m; i++)
 				for (int j = 0; j < n; j++)
-					base[i][j] -= oth[i][j];
+					base[i * ld + j] -= oth(i, j);
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::operator+=(const T& value)
 		{
-			for (auto& row : base)
-				for (auto& elem : row)
-					elem += value;
+			for (uint128_t i = 0; i < nrows; i++)
+			{
+				T* row = base.data() + i * ld;
+				for (uint128_t j = 0; j < ncols; j++)
+					row[j] += value;
+			}
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::operator-=(const T& value)
 		{
-			for (auto& row : base)
-				for (auto& elem : row)
-					elem -= value;
+			for (uint128_t i = 0; i < nrows; i++)
+			{
+				T* row = base.data() + i * ld;
+				for (uint128_t j = 0; j < ncols; j++)
+					row[j] -= value;
+			}
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::operator*=(const T& value)
 		{
-			for (auto& row : base)
-				for (auto& elem : row)
-					elem *= value;
+			for (uint128_t i = 0; i < nrows; i++)
+			{
+				T* row = base.data() + i * ld;
+				if constexpr (typing::is_simd_v<T>)
+					simd::scale(row, value, ncols);
+				else
+					for (uint128_t j = 0; j < ncols; j++)
+						row[j] *= value;
+			}
 			return *this;
 		}
 
 		template<typename T>
 		inline matrix_base<T>& matrix_base<T>::operator/=(const T& value)
 		{
-			for (auto& row : base)
-				for (auto& elem : row)
-					elem /= value;
+			for (uint128_t i = 0; i < nrows; i++)
+			{
+				T* row = base.data() + i * ld;
+				for (uint128_t j = 0; j < ncols; j++)
+					row[j] /= value;
+			}
 			return *this;
 		}
 
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator+(const V& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] + value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator-(const V& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] - value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator*(const V& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] * value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator/(const V& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<T>, matrix_base<V>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] / value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator+(const complex_base<V>& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<complex_base<T>>, matrix_base<complex_base<V>>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] + value;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator-(const complex_base<V>& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<complex_base<T>>, matrix_base<complex_base<V>>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] - value;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator*(const complex_base<V>& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<complex_base<T>>, matrix_base<complex_base<V>>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] * value;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto matrix_base<T>::operator/(const complex_base<V>& value) const
-		{
-			auto [m, n] = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, matrix_base<complex_base<T>>, matrix_base<complex_base<V>>> result(m, n);
-			for (int i = 0; i < m; i++)
-				for (int j = 0; j < n; j++)
-					result[i][j] = base[i][j] / value;
-		}
-	}
-
-	matr32f_t identity_matrix(uint128_t n)
-	{
-		return matr32f_t(n).fill_diagonal(1);
-	}
-
-	template<typename T>
-	base_type::matrix_base<T> diagonal(const uint128_t& n, const T& value)
-	{
-		return base_type::matrix_base<T>(n).fill_diagonal(value);
-	}
-
-	template<typename T>
-	base_type::matrix_base<T> diagonal(const base_type::vector_base<T>& values)
-	{
-		return base_type::matrix_base<T>(values.size()).fill_diagonal(values);
-	}
-
-	template<typename T>
-	base_type::matrix_base<T> multidiagonal(const uint128_t& n, const std::initializer_list<std::pair<int32_t, T>>& values)
-	{
-		base_type::matrix_base<T> matrix(n);
-		for (auto& pair : values)
-			matrix.fill_diagonal(pair.second, pair.first);
-		return matrix;
-	}
-
-	template<typename T>
-	base_type::matrix_base<T> multidiagonal(const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& values)
-	{
-		base_type::matrix_base<T> matrix(values.begin()->second.size());
-		for (auto& pair : values)
-			matrix.fill_diagonal(pair.second, pair.first);
-		return matrix;
 	}
 
 	template<typename T>
@@ -724,132 +828,4 @@ inline std::ostream& operator<<(std::ostream& out, const nm::base_type::matrix_b
 	}
 	out << typeid(matrix).name() << "\n";
 	return out;
-}
-
-template<typename T, typename V>
-inline auto operator+(const V& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using MT = nm::base_type::matrix_base<T>;
-	using MV = nm::base_type::matrix_base<V>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value + matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator-(const V& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using MT = nm::base_type::matrix_base<T>;
-	using MV = nm::base_type::matrix_base<V>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value - matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator*(const V& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using MT = nm::base_type::matrix_base<T>;
-	using MV = nm::base_type::matrix_base<V>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value * matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator/(const V& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using MT = nm::base_type::matrix_base<T>;
-	using MV = nm::base_type::matrix_base<V>;
-
-	auto [m, n] = matrix.size(); 
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value / matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator+(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using MT = nm::base_type::matrix_base<CT>;
-	using MV = nm::base_type::matrix_base<CV>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-	
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value + matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator-(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using MT = nm::base_type::matrix_base<CT>;
-	using MV = nm::base_type::matrix_base<CV>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value - matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator*(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using MT = nm::base_type::matrix_base<CT>;
-	using MV = nm::base_type::matrix_base<CV>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value * matrix.base[i][j];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator/(const nm::base_type::complex_base<V>& value, const nm::base_type::matrix_base<T>& matrix)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using MT = nm::base_type::matrix_base<CT>;
-	using MV = nm::base_type::matrix_base<CV>;
-
-	auto [m, n] = matrix.size();
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, MT, MV> result(matrix.size());
-
-	for (int i = 0; i < m; i++)
-		for (int j = 0; j < n; j++)
-			result[i][j] = value / matrix.base[i][j];
-	return result;
-}
+}
\ No newline at end of file
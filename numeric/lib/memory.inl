@@ -0,0 +1,274 @@
+#include "../include/memory.hpp"
+
+namespace nm
+{
+	namespace memory
+	{
+		inline thread_local resource* thread_resource = nullptr;
+
+		inline resource* current()
+		{
+			return thread_resource ? thread_resource : std::pmr::new_delete_resource();
+		}
+
+		inline resource* exchange(resource* res)
+		{
+			resource* previous = current();
+			thread_resource = res;
+			return previous;
+		}
+
+		inline bool is_aligned(const void* p, uint128_t alignment)
+		{
+			return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+		}
+
+		template<typename T>
+		inline uint128_t padded_ld(uint128_t n)
+		{
+			if (n == 0 || ALIGNMENT % sizeof(T) != 0)
+				return n;
+
+			constexpr uint128_t line = ALIGNMENT / sizeof(T);
+			uint128_t lines = (n + line - 1) / line;
+			if (lines % 8 == 0)
+				lines++;
+			return lines * line;
+		}
+
+		inline scope::scope(resource& res) :
+			previous(exchange(&res))
+		{
+		}
+
+		inline scope::~scope()
+		{
+			exchange(previous);
+		}
+
+		inline arena::arena(uint128_t block_size, resource* upstream) :
+			upstream(upstream),
+			block_size(block_size),
+			blocks(nullptr),
+			top(nullptr),
+			end(nullptr),
+			nused(0),
+			ncapacity(0)
+		{
+			assert(block_size > sizeof(block));
+		}
+
+		inline arena::~arena()
+		{
+			release();
+		}
+
+		inline void arena::reset()
+		{
+			if (!blocks)
+				return;
+
+			while (blocks->next)
+			{
+				block* next = blocks->next;
+				ncapacity -= next->size;
+				blocks->next = next->next;
+				upstream->deallocate(next, next->size, alignof(std::max_align_t));
+			}
+			top = reinterpret_cast<char*>(blocks + 1);
+			end = reinterpret_cast<char*>(blocks) + blocks->size;
+			nused = 0;
+		}
+
+		inline void arena::release()
+		{
+			while (blocks)
+			{
+				block* next = blocks->next;
+				upstream->deallocate(blocks, blocks->size, alignof(std::max_align_t));
+				blocks = next;
+			}
+			top = end = nullptr;
+			nused = ncapacity = 0;
+		}
+
+		inline uint128_t arena::used() const
+		{
+			return nused;
+		}
+
+		inline uint128_t arena::capacity() const
+		{
+			return ncapacity;
+		}
+
+		inline void* arena::do_allocate(size_t bytes, size_t alignment)
+		{
+			auto align = [&](char* p)
+			{
+				auto address = reinterpret_cast<uintptr_t>(p);
+				return p + ((alignment - address % alignment) % alignment);
+			};
+
+			char* p = top ? align(top) : nullptr;
+			if (!p || p + bytes > end)
+			{
+				// a new block, large requests get a block of their own size
+				uint128_t size = std::max<uint128_t>(block_size, sizeof(block) + bytes + alignment);
+				auto fresh = static_cast<block*>(upstream->allocate(size, alignof(std::max_align_t)));
+				fresh->next = blocks;
+				fresh->size = size;
+				blocks = fresh;
+				ncapacity += size;
+				top = reinterpret_cast<char*>(fresh + 1);
+				end = reinterpret_cast<char*>(fresh) + size;
+				p = align(top);
+			}
+			top = p + bytes;
+			nused += bytes;
+			return p;
+		}
+
+		inline void arena::do_deallocate(void*, size_t, size_t)
+		{
+		}
+
+		inline bool arena::do_is_equal(const resource& oth) const noexcept
+		{
+			return this == &oth;
+		}
+
+		inline pool::pool(uint128_t max_block, resource* upstream) :
+			upstream(upstream),
+			nmax(max_block),
+			lists{}
+		{
+			assert(max_block >= MIN_BLOCK && max_block < (uint128_t(1) << (CLASSES - 1)));
+		}
+
+		inline pool::~pool()
+		{
+			release();
+		}
+
+		inline void pool::release()
+		{
+			for (auto& [chunk, size] : chunks)
+				upstream->deallocate(chunk, size, std::min<uint128_t>(size, 4096));
+			chunks.clear();
+			std::fill_n(lists, CLASSES, nullptr);
+		}
+
+		inline uint128_t pool::max_block() const
+		{
+			return nmax;
+		}
+
+		inline uint128_t pool::size_class(size_t bytes, size_t alignment) const
+		{
+			// smallest power of two >= bytes, alignment and MIN_BLOCK
+			uint128_t size = std::max<uint128_t>({ bytes, alignment, MIN_BLOCK });
+			uint128_t k = 0;
+			while ((MIN_BLOCK << k) < size)
+				k++;
+			return k;
+		}
+
+		inline void* pool::do_allocate(size_t bytes, size_t alignment)
+		{
+			if (bytes > nmax || alignment > 4096)
+				return upstream->allocate(bytes, alignment);
+
+			uint128_t k = size_class(bytes, alignment);
+			if (!lists[k])
+			{
+				// carve a new chunk into blocks of this class, blocks are aligned
+				// to their size (up to a page) since the chunk is
+				uint128_t size = MIN_BLOCK << k;
+				uint128_t chunk_size = std::max<uint128_t>(size, 1 << 16);
+				char* chunk = static_cast<char*>(upstream->allocate(chunk_size, std::min<uint128_t>(chunk_size, 4096)));
+				chunks.emplace_back(chunk, chunk_size);
+				for (uint128_t offset = chunk_size; offset >= size; offset -= size)
+				{
+					auto n = reinterpret_cast<node*>(chunk + offset - size);
+					n->next = lists[k];
+					lists[k] = n;
+				}
+			}
+
+			node* n = lists[k];
+			lists[k] = n->next;
+			return n;
+		}
+
+		inline void pool::do_deallocate(void* p, size_t bytes, size_t alignment)
+		{
+			if (bytes > nmax || alignment > 4096)
+			{
+				upstream->deallocate(p, bytes, alignment);
+				return;
+			}
+
+			uint128_t k = size_class(bytes, alignment);
+			auto n = static_cast<node*>(p);
+			n->next = lists[k];
+			lists[k] = n;
+		}
+
+		inline bool pool::do_is_equal(const resource& oth) const noexcept
+		{
+			return this == &oth;
+		}
+
+		template<typename T>
+		inline allocator<T>::allocator() :
+			res(current())
+		{
+		}
+
+		template<typename T>
+		inline allocator<T>::allocator(resource* res) :
+			res(res)
+		{
+		}
+
+		template<typename T>
+		template<typename U>
+		inline allocator<T>::allocator(const allocator<U>& oth) :
+			res(oth.res)
+		{
+		}
+
+		template<typename T>
+		inline T* allocator<T>::allocate(size_t n)
+		{
+			return static_cast<T*>(res->allocate(n * sizeof(T), std::max<size_t>(alignof(T), ALIGNMENT)));
+		}
+
+		template<typename T>
+		inline void allocator<T>::deallocate(T* p, size_t n)
+		{
+			res->deallocate(p, n * sizeof(T), std::max<size_t>(alignof(T), ALIGNMENT));
+		}
+
+		template<typename T>
+		inline allocator<T> allocator<T>::select_on_container_copy_construction() const
+		{
+			return allocator();
+		}
+
+		template<typename T>
+		template<typename U>
+		inline bool allocator<T>::operator ==(const allocator<U>& oth) const
+		{
+			return res == oth.res || res->is_equal(*oth.res);
+		}
+
+		template<typename T>
+		template<typename U>
+		inline bool allocator<T>::operator !=(const allocator<U>& oth) const
+		{
+			return !(*this == oth);
+		}
+	}
+}
@@ -29,7 +29,33 @@ namespace nm
 	template<typename T>
 	T max(base_type::matrix_base<T> mtr)
 	{
-		return mtr.
+		assert(mtr.rows() > 0 && mtr.cols() > 0);
+		T result = mtr(0, 0);
+		for (uint128_t i = 0; i < mtr.rows(); i++)
+			result = std::max(result, *std::max_element(mtr.data() + i * mtr.ld, mtr.data() + i * mtr.ld + mtr.cols()));
+		return result;
+	}
+
+	template<typename T>
+	T max(base_type::vector_base<T> vct)
+	{
+		return vct.max();
+	}
+
+	template<typename T>
+	T min(base_type::matrix_base<T> mtr)
+	{
+		assert(mtr.rows() > 0 && mtr.cols() > 0);
+		T result = mtr(0, 0);
+		for (uint128_t i = 0; i < mtr.rows(); i++)
+			result = std::min(result, *std::min_element(mtr.data() + i * mtr.ld, mtr.data() + i * mtr.ld + mtr.cols()));
+		return result;
+	}
+
+	template<typename T>
+	T min(base_type::vector_base<T> vct)
+	{
+		return vct.min();
 	}
 
 }
\ No newline at end of file
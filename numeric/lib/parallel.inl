@@ -0,0 +1,177 @@
+#include "../include/parallel.hpp"
+
+namespace nm
+{
+	namespace parallel
+	{
+		// set in worker threads and during 'run', nested parallel_for runs serially
+		inline thread_local bool inside_task = false;
+
+		inline thread_pool::thread_pool(uint128_t nworkers) :
+			job(nullptr),
+			njobs(0),
+			next(0),
+			finished(0),
+			active(0),
+			generation(0),
+			stop(false)
+		{
+			workers.reserve(nworkers);
+			for (uint128_t i = 0; i < nworkers; i++)
+				workers.emplace_back([this] { worker(); });
+		}
+
+		inline thread_pool::~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stop = true;
+			}
+			wake.notify_all();
+			for (auto& thread : workers)
+				thread.join();
+		}
+
+		inline uint128_t thread_pool::size() const
+		{
+			return workers.size() + 1;
+		}
+
+		inline void thread_pool::run(uint128_t ntasks, const std::function<void(uint128_t)>& task)
+		{
+			// one run at a time, other callers do their work themselves
+			std::unique_lock<std::mutex> owner(busy, std::try_to_lock);
+			if (!owner || workers.empty())
+			{
+				for (uint128_t i = 0; i < ntasks; i++)
+					task(i);
+				return;
+			}
+
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				done.wait(lock, [this] { return active == 0; });
+				job = &task;
+				njobs = ntasks;
+				next = 0;
+				finished = 0;
+				generation++;
+			}
+			wake.notify_all();
+
+			inside_task = true;
+			execute();
+			inside_task = false;
+
+			std::unique_lock<std::mutex> lock(mutex);
+			done.wait(lock, [this] { return finished == njobs && active == 0; });
+			job = nullptr;
+		}
+
+		inline void thread_pool::worker()
+		{
+			inside_task = true;
+			uint128_t seen = 0;
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					wake.wait(lock, [&] { return stop || generation != seen; });
+					if (stop)
+						return;
+					seen = generation;
+					active++;
+				}
+
+				execute();
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					active--;
+				}
+				done.notify_all();
+			}
+		}
+
+		inline void thread_pool::execute()
+		{
+			for (auto i = next++; i < njobs; i = next++)
+			{
+				(*job)(i);
+				finished++;
+			}
+		}
+
+		inline uint128_t& thread_count()
+		{
+			static uint128_t value = std::max(1u, std::thread::hardware_concurrency());
+			return value;
+		}
+
+		inline uint128_t& cutoff_value()
+		{
+			static uint128_t value = PARALLEL_SERIAL_CUTOFF;
+			return value;
+		}
+
+		inline uint128_t threads()
+		{
+#ifdef PARALLEL_PRODUCT
+			return thread_count();
+#else
+			return 1;
+#endif
+		}
+
+		inline void set_threads(uint128_t n)
+		{
+			thread_count() = std::max<uint128_t>(n, 1);
+		}
+
+		inline uint128_t serial_cutoff()
+		{
+			return cutoff_value();
+		}
+
+		inline void set_serial_cutoff(uint128_t work)
+		{
+			cutoff_value() = work;
+		}
+
+		inline thread_pool& pool()
+		{
+			static std::mutex guard;
+			static std::unique_ptr<thread_pool> instance;
+
+			std::lock_guard<std::mutex> lock(guard);
+			if (!instance || instance->size() != threads())
+			{
+				instance.reset();
+				instance = std::make_unique<thread_pool>(threads() - 1);
+			}
+			return *instance;
+		}
+
+		template<typename F>
+		inline void parallel_for(uint128_t begin, uint128_t end, uint128_t work, F&& body)
+		{
+			if (begin >= end)
+				return;
+
+#ifdef PARALLEL_PRODUCT
+			auto count = std::min(threads(), end - begin);
+			if (count > 1 && work >= serial_cutoff() && !inside_task)
+			{
+				auto length = end - begin;
+				std::function<void(uint128_t)> task = [&](uint128_t t)
+				{
+					body(begin + length * t / count, begin + length * (t + 1) / count);
+				};
+				pool().run(count, task);
+				return;
+			}
+#endif
+			body(begin, end);
+		}
+	}
+}
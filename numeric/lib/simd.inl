@@ -0,0 +1,648 @@
+#include "../include/simd.hpp"
+
+namespace nm
+{
+	namespace simd
+	{
+		namespace scalar
+		{
+			template<typename T>
+			inline T sum(const T* x, uint128_t n)
+			{
+				T result = 0;
+				for (uint128_t i = 0; i < n; i++)
+					result += x[i];
+				return result;
+			}
+
+			template<typename T>
+			inline T dot(const T* x, const T* y, uint128_t n)
+			{
+				T result = 0;
+				for (uint128_t i = 0; i < n; i++)
+					result += x[i] * y[i];
+				return result;
+			}
+
+			template<typename T>
+			inline T sumsq(const T* x, uint128_t n)
+			{
+				return dot(x, x, n);
+			}
+
+			template<typename T>
+			inline T sumabs(const T* x, uint128_t n)
+			{
+				T result = 0;
+				for (uint128_t i = 0; i < n; i++)
+					result += std::abs(x[i]);
+				return result;
+			}
+
+			template<typename T>
+			inline T maxabs(const T* x, uint128_t n)
+			{
+				T result = 0;
+				for (uint128_t i = 0; i < n; i++)
+					result = std::max(result, std::abs(x[i]));
+				return result;
+			}
+
+			template<typename T>
+			inline T max(const T* x, uint128_t n)
+			{
+				return *std::max_element(x, x + n);
+			}
+
+			template<typename T>
+			inline T min(const T* x, uint128_t n)
+			{
+				return *std::min_element(x, x + n);
+			}
+
+			template<typename T>
+			inline void add(T* x, const T* y, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+					x[i] += y[i];
+			}
+
+			template<typename T>
+			inline void sub(T* x, const T* y, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+					x[i] -= y[i];
+			}
+
+			template<typename T>
+			inline void scale(T* x, T alpha, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+					x[i] *= alpha;
+			}
+
+			template<typename T>
+			inline void fill(T* x, T value, uint128_t n)
+			{
+				std::fill_n(x, n, value);
+			}
+
+			template<typename T>
+			inline void copy(T* x, const T* y, uint128_t n)
+			{
+				std::copy_n(y, n, x);
+			}
+
+			template<typename T>
+			inline void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb)
+			{
+				for (uint128_t i = 0; i < m; i++)
+					for (uint128_t j = 0; j < n; j++)
+						b[j * ldb + i] = a[i * lda + j];
+			}
+
+			template<typename T>
+			inline void cmul(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+				{
+					T re = ar[i] * br[i] - ai[i] * bi[i];
+					T im = ar[i] * bi[i] + ai[i] * br[i];
+					cr[i] = re;
+					ci[i] = im;
+				}
+			}
+
+			template<typename T>
+			inline void cdiv(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+				{
+					T qsum = br[i] * br[i] + bi[i] * bi[i];
+					T re = (ar[i] * br[i] + ai[i] * bi[i]) / qsum;
+					T im = (ai[i] * br[i] - ar[i] * bi[i]) / qsum;
+					cr[i] = re;
+					ci[i] = im;
+				}
+			}
+
+			template<typename T>
+			inline void cabs(const T* ar, const T* ai, T* c, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+					c[i] = std::sqrt(ar[i] * ar[i] + ai[i] * ai[i]);
+			}
+
+			template<typename T>
+			inline void cscale(T* xr, T* xi, T alpha_re, T alpha_im, uint128_t n)
+			{
+				for (uint128_t i = 0; i < n; i++)
+				{
+					T re = xr[i] * alpha_re - xi[i] * alpha_im;
+					xi[i] = xr[i] * alpha_im + xi[i] * alpha_re;
+					xr[i] = re;
+				}
+			}
+		}
+
+#ifdef NUMERIC_SIMD_X86
+
+	// every namespace below is compiled for its own instruction set, so
+	// the library does not need -mavx2 / -mavx512f or /arch flags
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+		namespace sse2
+		{
+			template<typename T> struct vec;
+
+			template<>
+			struct vec<float32_t>
+			{
+				using type = __m128;
+				static constexpr uint128_t width = 4;
+
+				static type zero() { return _mm_setzero_ps(); }
+				static type set1(float32_t value) { return _mm_set1_ps(value); }
+				static type load(const float32_t* ptr) { return _mm_loadu_ps(ptr); }
+				static void store(float32_t* ptr, type v) { _mm_storeu_ps(ptr, v); }
+				static void stream(float32_t* ptr, type v) { _mm_stream_ps(ptr, v); }
+				static type add(type a, type b) { return _mm_add_ps(a, b); }
+				static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+				static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+				static type div(type a, type b) { return _mm_div_ps(a, b); }
+				static type sqrt(type a) { return _mm_sqrt_ps(a); }
+				static type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+				static type max(type a, type b) { return _mm_max_ps(a, b); }
+				static type min(type a, type b) { return _mm_min_ps(a, b); }
+				static type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+
+				// register tile transpose, b = a^T for a tile x tile block
+				static constexpr uint128_t tile = 4;
+				static void transpose(const float32_t* a, uint128_t lda, float32_t* b, uint128_t ldb)
+				{
+					type r0 = load(a), r1 = load(a + lda), r2 = load(a + 2 * lda), r3 = load(a + 3 * lda);
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+					store(b, r0); store(b + ldb, r1); store(b + 2 * ldb, r2); store(b + 3 * ldb, r3);
+				}
+			};
+
+			template<>
+			struct vec<float64_t>
+			{
+				using type = __m128d;
+				static constexpr uint128_t width = 2;
+
+				static type zero() { return _mm_setzero_pd(); }
+				static type set1(float64_t value) { return _mm_set1_pd(value); }
+				static type load(const float64_t* ptr) { return _mm_loadu_pd(ptr); }
+				static void store(float64_t* ptr, type v) { _mm_storeu_pd(ptr, v); }
+				static void stream(float64_t* ptr, type v) { _mm_stream_pd(ptr, v); }
+				static type add(type a, type b) { return _mm_add_pd(a, b); }
+				static type sub(type a, type b) { return _mm_sub_pd(a, b); }
+				static type mul(type a, type b) { return _mm_mul_pd(a, b); }
+				static type div(type a, type b) { return _mm_div_pd(a, b); }
+				static type sqrt(type a) { return _mm_sqrt_pd(a); }
+				static type fmadd(type a, type b, type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+				static type max(type a, type b) { return _mm_max_pd(a, b); }
+				static type min(type a, type b) { return _mm_min_pd(a, b); }
+				static type abs(type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+
+				static constexpr uint128_t tile = 2;
+				static void transpose(const float64_t* a, uint128_t lda, float64_t* b, uint128_t ldb)
+				{
+					type r0 = load(a), r1 = load(a + lda);
+					store(b, _mm_unpacklo_pd(r0, r1));
+					store(b + ldb, _mm_unpackhi_pd(r0, r1));
+				}
+			};
+
+			#include "simd_kernels.inl"
+		}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+		namespace avx2
+		{
+			template<typename T> struct vec;
+
+			template<>
+			struct vec<float32_t>
+			{
+				using type = __m256;
+				static constexpr uint128_t width = 8;
+
+				static type zero() { return _mm256_setzero_ps(); }
+				static type set1(float32_t value) { return _mm256_set1_ps(value); }
+				static type load(const float32_t* ptr) { return _mm256_loadu_ps(ptr); }
+				static void store(float32_t* ptr, type v) { _mm256_storeu_ps(ptr, v); }
+				static void stream(float32_t* ptr, type v) { _mm256_stream_ps(ptr, v); }
+				static type add(type a, type b) { return _mm256_add_ps(a, b); }
+				static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+				static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+				static type div(type a, type b) { return _mm256_div_ps(a, b); }
+				static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+				static type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+				static type max(type a, type b) { return _mm256_max_ps(a, b); }
+				static type min(type a, type b) { return _mm256_min_ps(a, b); }
+				static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+
+				static constexpr uint128_t tile = 8;
+				static void transpose(const float32_t* a, uint128_t lda, float32_t* b, uint128_t ldb)
+				{
+					__m256 r[8], t[8];
+					for (uint128_t i = 0; i < 8; i++)
+						r[i] = _mm256_loadu_ps(a + i * lda);
+					for (uint128_t i = 0; i < 8; i += 2)
+					{
+						t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+						t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+					}
+					for (uint128_t i = 0; i < 8; i += 4)
+					{
+						r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+						r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+						r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+						r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+					}
+					for (uint128_t i = 0; i < 4; i++)
+					{
+						_mm256_storeu_ps(b + i * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+						_mm256_storeu_ps(b + (i + 4) * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+					}
+				}
+			};
+
+			template<>
+			struct vec<float64_t>
+			{
+				using type = __m256d;
+				static constexpr uint128_t width = 4;
+
+				static type zero() { return _mm256_setzero_pd(); }
+				static type set1(float64_t value) { return _mm256_set1_pd(value); }
+				static type load(const float64_t* ptr) { return _mm256_loadu_pd(ptr); }
+				static void store(float64_t* ptr, type v) { _mm256_storeu_pd(ptr, v); }
+				static void stream(float64_t* ptr, type v) { _mm256_stream_pd(ptr, v); }
+				static type add(type a, type b) { return _mm256_add_pd(a, b); }
+				static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+				static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+				static type div(type a, type b) { return _mm256_div_pd(a, b); }
+				static type sqrt(type a) { return _mm256_sqrt_pd(a); }
+				static type fmadd(type a, type b, type c) { return _mm256_fmadd_pd(a, b, c); }
+				static type max(type a, type b) { return _mm256_max_pd(a, b); }
+				static type min(type a, type b) { return _mm256_min_pd(a, b); }
+				static type abs(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+
+				static constexpr uint128_t tile = 4;
+				static void transpose(const float64_t* a, uint128_t lda, float64_t* b, uint128_t ldb)
+				{
+					type r0 = load(a), r1 = load(a + lda), r2 = load(a + 2 * lda), r3 = load(a + 3 * lda);
+					type t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+					type t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+					store(b, _mm256_permute2f128_pd(t0, t2, 0x20));
+					store(b + ldb, _mm256_permute2f128_pd(t1, t3, 0x20));
+					store(b + 2 * ldb, _mm256_permute2f128_pd(t0, t2, 0x31));
+					store(b + 3 * ldb, _mm256_permute2f128_pd(t1, t3, 0x31));
+				}
+			};
+
+			#include "simd_kernels.inl"
+		}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+		namespace avx512
+		{
+			template<typename T> struct vec;
+
+			template<>
+			struct vec<float32_t>
+			{
+				using type = __m512;
+				static constexpr uint128_t width = 16;
+
+				static type zero() { return _mm512_setzero_ps(); }
+				static type set1(float32_t value) { return _mm512_set1_ps(value); }
+				static type load(const float32_t* ptr) { return _mm512_loadu_ps(ptr); }
+				static void store(float32_t* ptr, type v) { _mm512_storeu_ps(ptr, v); }
+				static void stream(float32_t* ptr, type v) { _mm512_stream_ps(ptr, v); }
+				static type add(type a, type b) { return _mm512_add_ps(a, b); }
+				static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+				static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+				static type div(type a, type b) { return _mm512_div_ps(a, b); }
+				// sqrt, max, min: full-mask maskz_ forms, the plain ones of gcc merge into an undefined register
+				static type sqrt(type a) { return _mm512_maskz_sqrt_ps(0xffff, a); }
+				static type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+				static type max(type a, type b) { return _mm512_maskz_max_ps(0xffff, a, b); }
+				static type min(type a, type b) { return _mm512_maskz_min_ps(0xffff, a, b); }
+				static type abs(type a) { return _mm512_abs_ps(a); }
+
+				// 8 x 8 tile in 256-bit registers
+				static constexpr uint128_t tile = 8;
+				static void transpose(const float32_t* a, uint128_t lda, float32_t* b, uint128_t ldb)
+				{
+					__m256 r[8], t[8];
+					for (uint128_t i = 0; i < 8; i++)
+						r[i] = _mm256_loadu_ps(a + i * lda);
+					for (uint128_t i = 0; i < 8; i += 2)
+					{
+						t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+						t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+					}
+					for (uint128_t i = 0; i < 8; i += 4)
+					{
+						r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+						r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+						r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+						r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+					}
+					for (uint128_t i = 0; i < 4; i++)
+					{
+						_mm256_storeu_ps(b + i * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+						_mm256_storeu_ps(b + (i + 4) * ldb, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+					}
+				}
+			};
+
+			template<>
+			struct vec<float64_t>
+			{
+				using type = __m512d;
+				static constexpr uint128_t width = 8;
+
+				static type zero() { return _mm512_setzero_pd(); }
+				static type set1(float64_t value) { return _mm512_set1_pd(value); }
+				static type load(const float64_t* ptr) { return _mm512_loadu_pd(ptr); }
+				static void store(float64_t* ptr, type v) { _mm512_storeu_pd(ptr, v); }
+				static void stream(float64_t* ptr, type v) { _mm512_stream_pd(ptr, v); }
+				static type add(type a, type b) { return _mm512_add_pd(a, b); }
+				static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+				static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+				static type div(type a, type b) { return _mm512_div_pd(a, b); }
+				static type sqrt(type a) { return _mm512_maskz_sqrt_pd(0xff, a); }
+				static type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+				static type max(type a, type b) { return _mm512_maskz_max_pd(0xff, a, b); }
+				static type min(type a, type b) { return _mm512_maskz_min_pd(0xff, a, b); }
+				static type abs(type a) { return _mm512_abs_pd(a); }
+
+				// two-source permutes only: the unpack and shuffle_f64x2 intrinsics
+				// of gcc merge into an undefined register, -Wuninitialized reports it
+				static constexpr uint128_t tile = 8;
+				static void transpose(const float64_t* a, uint128_t lda, float64_t* b, uint128_t ldb)
+				{
+					const __m512i lo = _mm512_setr_epi64(0, 8, 2, 10, 4, 12, 6, 14);
+					const __m512i hi = _mm512_setr_epi64(1, 9, 3, 11, 5, 13, 7, 15);
+					// 128-bit lanes: even lanes of both operands, then odd lanes
+					const __m512i even = _mm512_setr_epi64(0, 1, 4, 5, 8, 9, 12, 13);
+					const __m512i odd = _mm512_setr_epi64(2, 3, 6, 7, 10, 11, 14, 15);
+
+					type r[8], t[8];
+					for (uint128_t i = 0; i < 8; i++)
+						r[i] = load(a + i * lda);
+					for (uint128_t i = 0; i < 8; i += 2)
+					{
+						t[i] = _mm512_permutex2var_pd(r[i], lo, r[i + 1]);
+						t[i + 1] = _mm512_permutex2var_pd(r[i], hi, r[i + 1]);
+					}
+					for (uint128_t i = 0; i < 8; i += 4)
+					{
+						r[i] = _mm512_permutex2var_pd(t[i], even, t[i + 2]);
+						r[i + 1] = _mm512_permutex2var_pd(t[i], odd, t[i + 2]);
+						r[i + 2] = _mm512_permutex2var_pd(t[i + 1], even, t[i + 3]);
+						r[i + 3] = _mm512_permutex2var_pd(t[i + 1], odd, t[i + 3]);
+					}
+					store(b, _mm512_permutex2var_pd(r[0], even, r[4]));
+					store(b + ldb, _mm512_permutex2var_pd(r[2], even, r[6]));
+					store(b + 2 * ldb, _mm512_permutex2var_pd(r[1], even, r[5]));
+					store(b + 3 * ldb, _mm512_permutex2var_pd(r[3], even, r[7]));
+					store(b + 4 * ldb, _mm512_permutex2var_pd(r[0], odd, r[4]));
+					store(b + 5 * ldb, _mm512_permutex2var_pd(r[2], odd, r[6]));
+					store(b + 6 * ldb, _mm512_permutex2var_pd(r[1], odd, r[5]));
+					store(b + 7 * ldb, _mm512_permutex2var_pd(r[3], odd, r[7]));
+				}
+			};
+
+			#include "simd_kernels.inl"
+		}
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
+
+		inline isa_t detect()
+		{
+#ifdef NUMERIC_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			int nids = info[0];
+
+			__cpuid(info, 1);
+			bool sse2 = info[3] & (1 << 26);
+			bool fma = info[2] & (1 << 12);
+			bool avx = info[2] & (1 << 28);
+			bool osxsave = info[2] & (1 << 27);
+
+			// OS has to save ymm / zmm registers on context switch
+			bool ymm = false, zmm = false;
+			if (osxsave)
+			{
+				auto xcr = _xgetbv(0);
+				ymm = (xcr & 0x06) == 0x06;
+				zmm = (xcr & 0xe6) == 0xe6;
+			}
+
+			bool avx2 = false, avx512 = false;
+			if (nids >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				avx2 = info[1] & (1 << 5);
+				avx512 = info[1] & (1 << 16);
+			}
+
+			if (avx512 && zmm)
+				return isa_t::avx512;
+			if (avx2 && avx && fma && ymm)
+				return isa_t::avx2;
+			if (sse2)
+				return isa_t::sse2;
+#else
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f"))
+				return isa_t::avx512;
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return isa_t::avx2;
+			if (__builtin_cpu_supports("sse2"))
+				return isa_t::sse2;
+#endif
+#endif
+			return isa_t::scalar;
+		}
+
+		inline isa_t& active_isa()
+		{
+			static isa_t value = detect();
+			return value;
+		}
+
+		inline isa_t isa()
+		{
+			return active_isa();
+		}
+
+		inline void set_isa(isa_t isa)
+		{
+			auto supported = detect();
+			active_isa() = isa < supported ? isa : supported;
+		}
+
+#ifdef NUMERIC_SIMD_X86
+#define NUMERIC_SIMD_DISPATCH(kernel, ...)						\
+		if constexpr (typing::is_simd_v<T>)						\
+		{														\
+			switch (isa())										\
+			{													\
+			case isa_t::avx512:	return avx512::kernel(__VA_ARGS__);	\
+			case isa_t::avx2:	return avx2::kernel(__VA_ARGS__);	\
+			case isa_t::sse2:	return sse2::kernel(__VA_ARGS__);	\
+			default:			break;							\
+			}													\
+		}														\
+		return scalar::kernel(__VA_ARGS__)
+#else
+#define NUMERIC_SIMD_DISPATCH(kernel, ...)						\
+		return scalar::kernel(__VA_ARGS__)
+#endif
+
+		template<typename T>
+		inline T sum(const T* x, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(sum, x, n);
+		}
+
+		template<typename T>
+		inline T dot(const T* x, const T* y, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(dot, x, y, n);
+		}
+
+		template<typename T>
+		inline T sumsq(const T* x, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(sumsq, x, n);
+		}
+
+		template<typename T>
+		inline T sumabs(const T* x, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(sumabs, x, n);
+		}
+
+		template<typename T>
+		inline T maxabs(const T* x, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(maxabs, x, n);
+		}
+
+		template<typename T>
+		inline T max(const T* x, uint128_t n)
+		{
+			assert(n > 0);
+			NUMERIC_SIMD_DISPATCH(max, x, n);
+		}
+
+		template<typename T>
+		inline T min(const T* x, uint128_t n)
+		{
+			assert(n > 0);
+			NUMERIC_SIMD_DISPATCH(min, x, n);
+		}
+
+		template<typename T>
+		inline void add(T* x, const T* y, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(add, x, y, n);
+		}
+
+		template<typename T>
+		inline void sub(T* x, const T* y, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(sub, x, y, n);
+		}
+
+		template<typename T>
+		inline void scale(T* x, T alpha, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(scale, x, alpha, n);
+		}
+
+		template<typename T>
+		inline void fill(T* x, T value, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(fill, x, value, n);
+		}
+
+		template<typename T>
+		inline void copy(T* x, const T* y, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(copy, x, y, n);
+		}
+
+		template<typename T>
+		inline void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb)
+		{
+			NUMERIC_SIMD_DISPATCH(transpose, m, n, a, lda, b, ldb);
+		}
+
+		template<typename T>
+		inline void cmul(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(cmul, ar, ai, br, bi, cr, ci, n);
+		}
+
+		template<typename T>
+		inline void cdiv(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(cdiv, ar, ai, br, bi, cr, ci, n);
+		}
+
+		template<typename T>
+		inline void cabs(const T* ar, const T* ai, T* c, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(cabs, ar, ai, c, n);
+		}
+
+		template<typename T>
+		inline void cscale(T* xr, T* xi, T alpha_re, T alpha_im, uint128_t n)
+		{
+			NUMERIC_SIMD_DISPATCH(cscale, xr, xi, alpha_re, alpha_im, n);
+		}
+
+#undef NUMERIC_SIMD_DISPATCH
+	}
+}
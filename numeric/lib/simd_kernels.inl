@@ -0,0 +1,349 @@
+// Kernel bodies shared by every instruction set. This file is included
+// by 'simd.inl' inside the namespace of each instruction set, which
+// defines 'vec<T>' - thin wrapper over intrinsics of that set.
+
+template<typename T>
+inline T reduce_add(typename vec<T>::type v)
+{
+	T lanes[vec<T>::width];
+	vec<T>::store(lanes, v);
+	T result = 0;
+	for (uint128_t i = 0; i < vec<T>::width; i++)
+		result += lanes[i];
+	return result;
+}
+
+template<typename T>
+inline T reduce_max(typename vec<T>::type v)
+{
+	T lanes[vec<T>::width];
+	vec<T>::store(lanes, v);
+	return *std::max_element(lanes, lanes + vec<T>::width);
+}
+
+template<typename T>
+inline T reduce_min(typename vec<T>::type v)
+{
+	T lanes[vec<T>::width];
+	vec<T>::store(lanes, v);
+	return *std::min_element(lanes, lanes + vec<T>::width);
+}
+
+template<typename T>
+inline T sum(const T* x, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc0 = V::zero();
+	auto acc1 = V::zero();
+	uint128_t i = 0;
+	for (; i + 2 * W <= n; i += 2 * W)
+	{
+		acc0 = V::add(acc0, V::load(x + i));
+		acc1 = V::add(acc1, V::load(x + i + W));
+	}
+	for (; i + W <= n; i += W)
+		acc0 = V::add(acc0, V::load(x + i));
+
+	T result = reduce_add<T>(V::add(acc0, acc1));
+	for (; i < n; i++)
+		result += x[i];
+	return result;
+}
+
+template<typename T>
+inline T dot(const T* x, const T* y, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc0 = V::zero();
+	auto acc1 = V::zero();
+	uint128_t i = 0;
+	for (; i + 2 * W <= n; i += 2 * W)
+	{
+		acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+		acc1 = V::fmadd(V::load(x + i + W), V::load(y + i + W), acc1);
+	}
+	for (; i + W <= n; i += W)
+		acc0 = V::fmadd(V::load(x + i), V::load(y + i), acc0);
+
+	T result = reduce_add<T>(V::add(acc0, acc1));
+	for (; i < n; i++)
+		result += x[i] * y[i];
+	return result;
+}
+
+template<typename T>
+inline T sumsq(const T* x, uint128_t n)
+{
+	return dot(x, x, n);
+}
+
+template<typename T>
+inline T sumabs(const T* x, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc0 = V::zero();
+	auto acc1 = V::zero();
+	uint128_t i = 0;
+	for (; i + 2 * W <= n; i += 2 * W)
+	{
+		acc0 = V::add(acc0, V::abs(V::load(x + i)));
+		acc1 = V::add(acc1, V::abs(V::load(x + i + W)));
+	}
+	for (; i + W <= n; i += W)
+		acc0 = V::add(acc0, V::abs(V::load(x + i)));
+
+	T result = reduce_add<T>(V::add(acc0, acc1));
+	for (; i < n; i++)
+		result += std::abs(x[i]);
+	return result;
+}
+
+template<typename T>
+inline T maxabs(const T* x, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc = V::zero();
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		acc = V::max(acc, V::abs(V::load(x + i)));
+
+	T result = reduce_max<T>(acc);
+	for (; i < n; i++)
+		result = std::max(result, std::abs(x[i]));
+	return result;
+}
+
+template<typename T>
+inline T max(const T* x, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc = V::set1(x[0]);
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		acc = V::max(acc, V::load(x + i));
+
+	T result = reduce_max<T>(acc);
+	for (; i < n; i++)
+		result = std::max(result, x[i]);
+	return result;
+}
+
+template<typename T>
+inline T min(const T* x, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto acc = V::set1(x[0]);
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		acc = V::min(acc, V::load(x + i));
+
+	T result = reduce_min<T>(acc);
+	for (; i < n; i++)
+		result = std::min(result, x[i]);
+	return result;
+}
+
+template<typename T>
+inline void add(T* x, const T* y, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		V::store(x + i, V::add(V::load(x + i), V::load(y + i)));
+	for (; i < n; i++)
+		x[i] += y[i];
+}
+
+template<typename T>
+inline void sub(T* x, const T* y, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		V::store(x + i, V::sub(V::load(x + i), V::load(y + i)));
+	for (; i < n; i++)
+		x[i] -= y[i];
+}
+
+template<typename T>
+inline void scale(T* x, T alpha, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto a = V::set1(alpha);
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+		V::store(x + i, V::mul(V::load(x + i), a));
+	for (; i < n; i++)
+		x[i] *= alpha;
+}
+
+// x is aligned to the register width first, buffers of STREAM_BYTES and
+// more are written with non-temporal stores, which bypass the cache
+
+template<typename T>
+inline void fill(T* x, T value, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i < n && reinterpret_cast<uintptr_t>(x + i) % (W * sizeof(T)) != 0; i++)
+		x[i] = value;
+
+	auto v = V::set1(value);
+	if (n * sizeof(T) >= STREAM_BYTES)
+	{
+		for (; i + W <= n; i += W)
+			V::stream(x + i, v);
+		_mm_sfence();
+	}
+	else
+		for (; i + W <= n; i += W)
+			V::store(x + i, v);
+	for (; i < n; i++)
+		x[i] = value;
+}
+
+template<typename T>
+inline void copy(T* x, const T* y, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i < n && reinterpret_cast<uintptr_t>(x + i) % (W * sizeof(T)) != 0; i++)
+		x[i] = y[i];
+
+	if (n * sizeof(T) >= STREAM_BYTES)
+	{
+		for (; i + W <= n; i += W)
+			V::stream(x + i, V::load(y + i));
+		_mm_sfence();
+	}
+	else
+		for (; i + W <= n; i += W)
+			V::store(x + i, V::load(y + i));
+	for (; i < n; i++)
+		x[i] = y[i];
+}
+
+// b = a^T for an m x n block: full tiles by the register transpose of
+// vec<T>, the edges element by element
+
+template<typename T>
+inline void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb)
+{
+	using V = vec<T>;
+	constexpr auto W = V::tile;
+	uint128_t i = 0;
+	for (; i + W <= m; i += W)
+	{
+		uint128_t j = 0;
+		for (; j + W <= n; j += W)
+			V::transpose(a + i * lda + j, lda, b + j * ldb + i, ldb);
+		for (; j < n; j++)
+			for (uint128_t k = i; k < i + W; k++)
+				b[j * ldb + k] = a[k * lda + j];
+	}
+	for (; i < m; i++)
+		for (uint128_t j = 0; j < n; j++)
+			b[j * ldb + i] = a[i * lda + j];
+}
+
+// split complex: real and imaginary parts in separate arrays, c may alias a or b
+
+template<typename T>
+inline void cmul(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+	{
+		auto xr = V::load(ar + i);
+		auto xi = V::load(ai + i);
+		auto yr = V::load(br + i);
+		auto yi = V::load(bi + i);
+		V::store(cr + i, V::sub(V::mul(xr, yr), V::mul(xi, yi)));
+		V::store(ci + i, V::fmadd(xr, yi, V::mul(xi, yr)));
+	}
+	for (; i < n; i++)
+	{
+		T re = ar[i] * br[i] - ai[i] * bi[i];
+		T im = ar[i] * bi[i] + ai[i] * br[i];
+		cr[i] = re;
+		ci[i] = im;
+	}
+}
+
+template<typename T>
+inline void cdiv(const T* ar, const T* ai, const T* br, const T* bi, T* cr, T* ci, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+	{
+		auto xr = V::load(ar + i);
+		auto xi = V::load(ai + i);
+		auto yr = V::load(br + i);
+		auto yi = V::load(bi + i);
+		auto qsum = V::fmadd(yr, yr, V::mul(yi, yi));
+		V::store(cr + i, V::div(V::fmadd(xr, yr, V::mul(xi, yi)), qsum));
+		V::store(ci + i, V::div(V::sub(V::mul(xi, yr), V::mul(xr, yi)), qsum));
+	}
+	for (; i < n; i++)
+	{
+		T qsum = br[i] * br[i] + bi[i] * bi[i];
+		T re = (ar[i] * br[i] + ai[i] * bi[i]) / qsum;
+		T im = (ai[i] * br[i] - ar[i] * bi[i]) / qsum;
+		cr[i] = re;
+		ci[i] = im;
+	}
+}
+
+template<typename T>
+inline void cabs(const T* ar, const T* ai, T* c, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+	{
+		auto xr = V::load(ar + i);
+		auto xi = V::load(ai + i);
+		V::store(c + i, V::sqrt(V::fmadd(xr, xr, V::mul(xi, xi))));
+	}
+	for (; i < n; i++)
+		c[i] = std::sqrt(ar[i] * ar[i] + ai[i] * ai[i]);
+}
+
+template<typename T>
+inline void cscale(T* xr, T* xi, T alpha_re, T alpha_im, uint128_t n)
+{
+	using V = vec<T>;
+	constexpr auto W = V::width;
+	auto sr = V::set1(alpha_re);
+	auto si = V::set1(alpha_im);
+	uint128_t i = 0;
+	for (; i + W <= n; i += W)
+	{
+		auto re = V::load(xr + i);
+		auto im = V::load(xi + i);
+		V::store(xr + i, V::sub(V::mul(re, sr), V::mul(im, si)));
+		V::store(xi + i, V::fmadd(re, si, V::mul(im, sr)));
+	}
+	for (; i < n; i++)
+	{
+		T re = xr[i] * alpha_re - xi[i] * alpha_im;
+		xi[i] = xr[i] * alpha_im + xi[i] * alpha_re;
+		xr[i] = re;
+	}
+}
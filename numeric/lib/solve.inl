@@ -0,0 +1,103 @@
+#include "../include/solve.hpp"
+
+namespace nm
+{
+	template<typename T>
+	inline structure_t structure(const base_type::matrix_base<T>& matr)
+	{
+		assert(matr.is_square());
+		auto upper = matr.is_triangleU();
+		auto lower = matr.is_triangleL();
+
+		if (upper && lower)
+			return structure_t::diagonal;
+		if (upper)
+			return structure_t::upper;
+		if (lower)
+			return structure_t::lower;
+		if (matr.is_hermitian())
+			return structure_t::symmetric;
+		return structure_t::general;
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> solve(const base_type::matrix_base<T>& matr, const base_type::vector_base<T>& b)
+	{
+		auto n = matr.rows();
+		assert(b.size() == n);
+
+		base_type::vector_base<T> x(b);
+		auto type = structure(matr);
+		switch (type)
+		{
+		case structure_t::diagonal:
+			for (uint128_t i = 0; i < n; i++)
+			{
+				assert(matr(i, i) != 0);
+				x.base[i] /= matr(i, i);
+			}
+			return x;
+
+		case structure_t::upper:
+		case structure_t::lower:
+			for (uint128_t i = 0; i < n; i++)
+				assert(matr(i, i) != 0);
+			kernel::trsv(type == structure_t::lower, false, n, matr.data(), matr.ld, x.base.data());
+			return x;
+
+		case structure_t::symmetric:
+		{
+			// positive definiteness is checked by the factorization itself
+			auto factor = cholesky(matr);
+			if (factor.is_positive())
+				return factor.solve_inplace(x);
+			return lu(matr).solve_inplace(x);
+		}
+
+		default:
+			return lu(matr).solve_inplace(x);
+		}
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> solve(const base_type::matrix_base<T>& matr, const base_type::matrix_base<T>& b)
+	{
+		auto n = matr.rows();
+		auto k = b.cols();
+		assert(b.rows() == n);
+
+		base_type::matrix_base<T> x(b);
+		auto type = structure(matr);
+		switch (type)
+		{
+		case structure_t::diagonal:
+			for (uint128_t i = 0; i < n; i++)
+			{
+				assert(matr(i, i) != 0);
+				T pivot = T(1) / matr(i, i);
+				for (uint128_t j = 0; j < k; j++)
+					x(i, j) *= pivot;
+			}
+			return x;
+
+		case structure_t::upper:
+		case structure_t::lower:
+			for (uint128_t i = 0; i < n; i++)
+				assert(matr(i, i) != 0);
+			kernel::trsm(type == structure_t::lower, false, n, k, matr.data(), matr.ld, x.data(), x.ld);
+			return x;
+
+		case structure_t::symmetric:
+		{
+			// positive definiteness is checked by the factorization itself
+			auto factor = cholesky(matr);
+			if (factor.is_positive())
+				return factor.solve_inplace(x);
+			return lu(matr).solve_inplace(x);
+		}
+
+		default:
+			return lu(matr).solve_inplace(x);
+		}
+	}
+}
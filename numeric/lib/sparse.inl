@@ -0,0 +1,326 @@
+#include "../include/sparse.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// y_i = sum of a_k * x[index_k] over line i, lines [0, lines) are split between threads
+		template<typename TS, typename T, typename V>
+		inline void sparse_gather(uint128_t lines, const uint128_t* offsets, const uint128_t* indices, const T* values, const V* x, TS* y)
+		{
+			parallel::parallel_for(0, lines, offsets[lines], [&](uint128_t lo, uint128_t hi)
+			{
+				for (auto i = lo; i < hi; i++)
+				{
+					TS sum = 0;
+					for (auto k = offsets[i]; k < offsets[i + 1]; k++)
+						sum += values[k] * x[indices[k]];
+					y[i] = sum;
+				}
+			});
+		}
+
+		// y[index_k] += a_k * x_i over all lines i, every thread scatters into its own copy of y
+		template<typename TS, typename T, typename V>
+		inline memory::vector<TS> sparse_scatter(uint128_t lines, uint128_t size, const uint128_t* offsets, const uint128_t* indices, const T* values, const V* x)
+		{
+			return reduce_rows<TS>(0, lines, size, offsets[lines], [&](uint128_t i, TS* acc)
+			{
+				TS xi = x[i];
+				for (auto k = offsets[i]; k < offsets[i + 1]; k++)
+					acc[indices[k]] += values[k] * xi;
+			});
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline sparse_matrix<T>::sparse_matrix(uint128_t m, uint128_t n, sparse_format_t format)
+			: offsets((format == sparse_format_t::csr ? m : n) + 1, 0), nrows(m), ncols(n), layout(format)
+		{
+		}
+
+		template<typename T>
+		inline sparse_matrix<T>::sparse_matrix(const matrix_base<T>& matr, sparse_format_t format)
+			: sparse_matrix(matr.rows(), matr.cols(), format)
+		{
+			auto csr = format == sparse_format_t::csr;
+			auto major = csr ? nrows : ncols;
+			auto minor = csr ? ncols : nrows;
+			for (uint128_t i = 0; i < major; i++)
+			{
+				for (uint128_t j = 0; j < minor; j++)
+				{
+					const T& value = csr ? matr(i, j) : matr(j, i);
+					if (value != T(0))
+					{
+						indices.push_back(j);
+						values.push_back(value);
+					}
+				}
+				offsets[i + 1] = values.size();
+			}
+		}
+
+		template<typename T>
+		inline sparse_matrix<T>::sparse_matrix(uint128_t m, uint128_t n,
+			const std::vector<std::tuple<uint128_t, uint128_t, T>>& triplets, sparse_format_t format)
+			: sparse_matrix(m, n, format)
+		{
+			// counting sort by the major index, then every line is sorted and duplicates are summed
+			auto csr = format == sparse_format_t::csr;
+			auto major = csr ? nrows : ncols;
+			for (auto& [i, j, value] : triplets)
+			{
+				assert(i < m && j < n);
+				offsets[(csr ? i : j) + 1]++;
+			}
+			for (uint128_t i = 0; i < major; i++)
+				offsets[i + 1] += offsets[i];
+
+			std::vector<std::pair<uint128_t, T>> entries(triplets.size());
+			std::vector<uint128_t> next(offsets.begin(), offsets.end() - 1);
+			for (auto& [i, j, value] : triplets)
+				entries[next[csr ? i : j]++] = { csr ? j : i, value };
+
+			indices.reserve(entries.size());
+			values.reserve(entries.size());
+			uint128_t beg = 0;
+			for (uint128_t i = 0; i < major; i++)
+			{
+				auto end = offsets[i + 1];
+				std::sort(entries.begin() + beg, entries.begin() + end, [](const auto& x, const auto& y) { return x.first < y.first; });
+				for (auto k = beg; k < end; k++)
+				{
+					if (k > beg && entries[k].first == indices.back())
+						values.back() += entries[k].second;
+					else
+					{
+						indices.push_back(entries[k].first);
+						values.push_back(entries[k].second);
+					}
+				}
+				beg = end;
+				offsets[i + 1] = values.size();
+			}
+		}
+
+		template<typename T>
+		inline uint128_t sparse_matrix<T>::rows() const
+		{
+			return nrows;
+		}
+
+		template<typename T>
+		inline uint128_t sparse_matrix<T>::cols() const
+		{
+			return ncols;
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> sparse_matrix<T>::size() const
+		{
+			return std::make_pair(nrows, ncols);
+		}
+
+		template<typename T>
+		inline uint128_t sparse_matrix<T>::nonzeros() const
+		{
+			return values.size();
+		}
+
+		template<typename T>
+		inline sparse_format_t sparse_matrix<T>::format() const
+		{
+			return layout;
+		}
+
+		template<typename T>
+		inline T sparse_matrix<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			assert(i < nrows && j < ncols);
+			if (layout == sparse_format_t::csc)
+				std::swap(i, j);
+
+			auto beg = indices.begin() + offsets[i];
+			auto end = indices.begin() + offsets[i + 1];
+			auto it = std::lower_bound(beg, end, j);
+			if (it == end || *it != j)
+				return T(0);
+			return values[it - indices.begin()];
+		}
+
+		template<typename T>
+		inline sparse_matrix<T> sparse_matrix<T>::transposed() const
+		{
+			// csr of A is csc of A^T, arrays are not touched
+			sparse_matrix<T> result(*this);
+			std::swap(result.nrows, result.ncols);
+			result.layout = layout == sparse_format_t::csr ? sparse_format_t::csc : sparse_format_t::csr;
+			return result;
+		}
+
+		template<typename T>
+		inline sparse_matrix<T> sparse_matrix<T>::to_csr() const
+		{
+			if (layout == sparse_format_t::csr)
+				return *this;
+
+			// csc -> csr is a transposition of the compressed arrays: counting sort in O(nnz + m + n)
+			sparse_matrix<T> result(nrows, ncols, sparse_format_t::csr);
+			auto major = ncols;
+			auto minor = nrows;
+			for (auto index : indices)
+				result.offsets[index + 1]++;
+			for (uint128_t i = 0; i < minor; i++)
+				result.offsets[i + 1] += result.offsets[i];
+
+			result.indices.resize(values.size());
+			result.values.resize(values.size());
+			std::vector<uint128_t> next(result.offsets.begin(), result.offsets.end() - 1);
+			for (uint128_t j = 0; j < major; j++)
+			{
+				for (auto k = offsets[j]; k < offsets[j + 1]; k++)
+				{
+					auto pos = next[indices[k]]++;
+					result.indices[pos] = j;
+					result.values[pos] = values[k];
+				}
+			}
+			return result;
+		}
+
+		template<typename T>
+		inline sparse_matrix<T> sparse_matrix<T>::to_csc() const
+		{
+			if (layout == sparse_format_t::csc)
+				return *this;
+			return transposed().to_csr().transposed();
+		}
+
+		template<typename T>
+		inline matrix_base<T> sparse_matrix<T>::dense() const
+		{
+			matrix_base<T> result(nrows, ncols);
+			auto csr = layout == sparse_format_t::csr;
+			auto major = csr ? nrows : ncols;
+			for (uint128_t i = 0; i < major; i++)
+				for (auto k = offsets[i]; k < offsets[i + 1]; k++)
+				{
+					if (csr)
+						result(i, indices[k]) = values[k];
+					else
+						result(indices[k], i) = values[k];
+				}
+			return result;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline auto sparse_matrix<T>::operator*(const vector_base<V>& vec) const
+		{
+			assert(ncols == vec.size());
+
+			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
+			vector_base<TS> result(nrows);
+			if (layout == sparse_format_t::csr)
+				kernel::sparse_gather(nrows, offsets.data(), indices.data(), values.data(), vec.base.data(), result.base.data());
+			else
+				result.base = kernel::sparse_scatter<TS>(ncols, nrows, offsets.data(), indices.data(), values.data(), vec.base.data());
+			return result;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline auto sparse_matrix<T>::multiply_transposed(const vector_base<V>& vec) const
+		{
+			assert(nrows == vec.size());
+
+			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
+			vector_base<TS> result(ncols);
+			if (layout == sparse_format_t::csc)
+				kernel::sparse_gather(ncols, offsets.data(), indices.data(), values.data(), vec.base.data(), result.base.data());
+			else
+				result.base = kernel::sparse_scatter<TS>(nrows, ncols, offsets.data(), indices.data(), values.data(), vec.base.data());
+			return result;
+		}
+	}
+
+	template<typename T>
+	base_type::sparse_matrix<T> sparse_multidiagonal(const uint128_t& n, const std::initializer_list<std::pair<int32_t, T>>& values, sparse_format_t format)
+	{
+		// diagonals are sorted by offset, so every row is written already sorted by column
+		std::vector<std::pair<int32_t, T>> diagonals(values);
+		std::sort(diagonals.begin(), diagonals.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+
+		base_type::sparse_matrix<T> matrix(n, n);
+		matrix.indices.reserve(n * diagonals.size());
+		matrix.values.reserve(n * diagonals.size());
+		for (int128_t i = 0; i < int128_t(n); i++)
+		{
+			for (auto& [index, value] : diagonals)
+			{
+				auto j = i + index;
+				if (j >= 0 && j < int128_t(n) && value != T(0))
+				{
+					matrix.indices.push_back(j);
+					matrix.values.push_back(value);
+				}
+			}
+			matrix.offsets[i + 1] = matrix.values.size();
+		}
+		return format == sparse_format_t::csr ? matrix : matrix.to_csc();
+	}
+
+	template<typename T>
+	base_type::sparse_matrix<T> sparse_multidiagonal(const std::initializer_list<std::pair<int32_t, base_type::vector_base<T>>>& diagonals, sparse_format_t format)
+	{
+		// same specs as 'multidiagonal': diagonal k holds n - |k| values, from its top left end
+		int128_t n = diagonals.begin()->second.size() + std::abs(diagonals.begin()->first);
+		std::vector<const std::pair<int32_t, base_type::vector_base<T>>*> sorted;
+		for (auto& pair : diagonals)
+		{
+			assert(int128_t(pair.second.size()) == n - std::abs(pair.first));
+			sorted.push_back(&pair);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](auto x, auto y) { return x->first < y->first; });
+
+		base_type::sparse_matrix<T> matrix(n, n);
+		for (int128_t i = 0; i < n; i++)
+		{
+			for (auto pair : sorted)
+			{
+				auto index = pair->first;
+				auto j = i + index;
+				if (j < 0 || j >= n)
+					continue;
+
+				const T& value = pair->second.base[index < 0 ? j : i];
+				if (value != T(0))
+				{
+					matrix.indices.push_back(j);
+					matrix.values.push_back(value);
+				}
+			}
+			matrix.offsets[i + 1] = matrix.values.size();
+		}
+		return format == sparse_format_t::csr ? matrix : matrix.to_csc();
+	}
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::sparse_matrix<T>& matrix)
+{
+	auto csr = matrix.format() == nm::sparse_format_t::csr;
+	auto major = csr ? matrix.rows() : matrix.cols();
+	for (nm::uint128_t i = 0; i < major; i++)
+		for (auto k = matrix.offsets[i]; k < matrix.offsets[i + 1]; k++)
+		{
+			auto row = csr ? i : matrix.indices[k];
+			auto col = csr ? matrix.indices[k] : i;
+			out << "\t(" << row << ", " << col << ")\t" << matrix.values[k] << "\n";
+		}
+	out << typeid(matrix).name() << "\n";
+	return out;
+}
@@ -0,0 +1,408 @@
+#include "../include/split.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		template<typename T>
+		inline void deinterleave(const base_type::complex_base<T>* x, T* re, T* im, uint128_t n)
+		{
+			for (uint128_t i = 0; i < n; i++)
+			{
+				re[i] = x[i].real;
+				im[i] = x[i].imag;
+			}
+		}
+
+		template<typename T>
+		inline void interleave(const T* re, const T* im, base_type::complex_base<T>* x, uint128_t n)
+		{
+			for (uint128_t i = 0; i < n; i++)
+			{
+				x[i].real = re[i];
+				x[i].imag = im[i];
+			}
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline split_vector<T>::split_vector(uint128_t n) :
+			re(n, T(0)),
+			im(n, T(0))
+		{
+		}
+
+		template<typename T>
+		inline split_vector<T>::split_vector(uint128_t n, value_type value) :
+			re(n, value.real),
+			im(n, value.imag)
+		{
+		}
+
+		template<typename T>
+		inline split_vector<T>::split_vector(const vector_base<value_type>& vect) :
+			re(vect.size()),
+			im(vect.size())
+		{
+			kernel::deinterleave(vect.base.data(), re.data(), im.data(), vect.size());
+		}
+
+		template<typename T>
+		inline split_vector<T>::split_vector(const vector_base<T>& real, const vector_base<T>& imag) :
+			re(real.base),
+			im(imag.base)
+		{
+			assert(real.size() == imag.size());
+		}
+
+		template<typename T>
+		inline uint128_t split_vector<T>::size() const
+		{
+			return re.size();
+		}
+
+		template<typename T>
+		inline typename split_vector<T>::value_type split_vector<T>::operator [](uint128_t i) const
+		{
+			return value_type(re[i], im[i]);
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::set(uint128_t i, value_type value)
+		{
+			re[i] = value.real;
+			im[i] = value.imag;
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_base<typename split_vector<T>::value_type> split_vector<T>::interleaved() const
+		{
+			vector_base<value_type> result(size());
+			kernel::interleave(re.data(), im.data(), result.base.data(), size());
+			return result;
+		}
+
+		template<typename T>
+		inline split_vector<T>::operator vector_base<value_type>() const
+		{
+			return interleaved();
+		}
+
+		template<typename T>
+		inline vector_base<T> split_vector<T>::real() const
+		{
+			return vector_base<T>(re);
+		}
+
+		template<typename T>
+		inline vector_base<T> split_vector<T>::imag() const
+		{
+			return vector_base<T>(im);
+		}
+
+		template<typename T>
+		inline vector_base<T> split_vector<T>::abs() const
+		{
+			vector_base<T> result(size());
+			simd::cabs(re.data(), im.data(), result.base.data(), size());
+			return result;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::conjugate() const
+		{
+			split_vector result(*this);
+			simd::scale(result.im.data(), T(-1), size());
+			return result;
+		}
+
+		template<typename T>
+		inline typename split_vector<T>::value_type split_vector<T>::dot(const split_vector& oth) const
+		{
+			// (xr - i xi)(yr + i yi) = xr yr + xi yi + i (xr yi - xi yr)
+			assert(size() == oth.size());
+			auto n = size();
+			return value_type(
+				simd::dot(re.data(), oth.re.data(), n) + simd::dot(im.data(), oth.im.data(), n),
+				simd::dot(re.data(), oth.im.data(), n) - simd::dot(im.data(), oth.re.data(), n));
+		}
+
+		template<typename T>
+		inline T split_vector<T>::norm2() const
+		{
+			return std::sqrt(simd::sumsq(re.data(), size()) + simd::sumsq(im.data(), size()));
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator +=(const split_vector& oth)
+		{
+			assert(size() == oth.size());
+			simd::add(re.data(), oth.re.data(), size());
+			simd::add(im.data(), oth.im.data(), size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator -=(const split_vector& oth)
+		{
+			assert(size() == oth.size());
+			simd::sub(re.data(), oth.re.data(), size());
+			simd::sub(im.data(), oth.im.data(), size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator *=(const split_vector& oth)
+		{
+			assert(size() == oth.size());
+			simd::cmul(re.data(), im.data(), oth.re.data(), oth.im.data(), re.data(), im.data(), size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator /=(const split_vector& oth)
+		{
+			assert(size() == oth.size());
+			simd::cdiv(re.data(), im.data(), oth.re.data(), oth.im.data(), re.data(), im.data(), size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator *=(value_type value)
+		{
+			simd::cscale(re.data(), im.data(), value.real, value.imag, size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T>& split_vector<T>::operator /=(value_type value)
+		{
+			auto inv = value.inversed();
+			simd::cscale(re.data(), im.data(), inv.real, inv.imag, size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator +(const split_vector& oth) const
+		{
+			split_vector result(*this);
+			return result += oth;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator -(const split_vector& oth) const
+		{
+			split_vector result(*this);
+			return result -= oth;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator *(const split_vector& oth) const
+		{
+			assert(size() == oth.size());
+			split_vector result(size());
+			simd::cmul(re.data(), im.data(), oth.re.data(), oth.im.data(), result.re.data(), result.im.data(), size());
+			return result;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator /(const split_vector& oth) const
+		{
+			assert(size() == oth.size());
+			split_vector result(size());
+			simd::cdiv(re.data(), im.data(), oth.re.data(), oth.im.data(), result.re.data(), result.im.data(), size());
+			return result;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator *(value_type value) const
+		{
+			split_vector result(*this);
+			return result *= value;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_vector<T>::operator /(value_type value) const
+		{
+			split_vector result(*this);
+			return result /= value;
+		}
+
+		template<typename T>
+		inline split_matrix<T>::split_matrix(uint128_t m, uint128_t n) :
+			nrows(m),
+			ncols(n),
+			re(m * n, T(0)),
+			im(m * n, T(0))
+		{
+		}
+
+		template<typename T>
+		inline split_matrix<T>::split_matrix(const matrix_base<value_type>& matr) :
+			nrows(matr.rows()),
+			ncols(matr.cols()),
+			re(matr.rows() * matr.cols()),
+			im(matr.rows() * matr.cols())
+		{
+			for (uint128_t i = 0; i < nrows; i++)
+				kernel::deinterleave(matr.data() + i * matr.ld, re.data() + i * ncols, im.data() + i * ncols, ncols);
+		}
+
+		template<typename T>
+		inline uint128_t split_matrix<T>::rows() const
+		{
+			return nrows;
+		}
+
+		template<typename T>
+		inline uint128_t split_matrix<T>::cols() const
+		{
+			return ncols;
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> split_matrix<T>::size() const
+		{
+			return { nrows, ncols };
+		}
+
+		template<typename T>
+		inline typename split_matrix<T>::value_type split_matrix<T>::operator ()(uint128_t i, uint128_t j) const
+		{
+			return value_type(re[i * ncols + j], im[i * ncols + j]);
+		}
+
+		template<typename T>
+		inline split_matrix<T>& split_matrix<T>::set(uint128_t i, uint128_t j, value_type value)
+		{
+			re[i * ncols + j] = value.real;
+			im[i * ncols + j] = value.imag;
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_base<typename split_matrix<T>::value_type> split_matrix<T>::interleaved() const
+		{
+			matrix_base<value_type> result(nrows, ncols);
+			for (uint128_t i = 0; i < nrows; i++)
+				kernel::interleave(re.data() + i * ncols, im.data() + i * ncols, result.data() + i * result.ld, ncols);
+			return result;
+		}
+
+		template<typename T>
+		inline split_matrix<T>::operator matrix_base<value_type>() const
+		{
+			return interleaved();
+		}
+
+		template<typename T>
+		inline matrix_base<T> split_matrix<T>::abs() const
+		{
+			matrix_base<T> result(nrows, ncols);
+			for (uint128_t i = 0; i < nrows; i++)
+				simd::cabs(re.data() + i * ncols, im.data() + i * ncols, result.data() + i * result.ld, ncols);
+			return result;
+		}
+
+		template<typename T>
+		inline split_matrix<T> split_matrix<T>::conjugate() const
+		{
+			split_matrix result(ncols, nrows);
+			for (uint128_t i = 0; i < nrows; i++)
+			{
+				for (uint128_t j = 0; j < ncols; j++)
+				{
+					result.re[j * nrows + i] = re[i * ncols + j];
+					result.im[j * nrows + i] = -im[i * ncols + j];
+				}
+			}
+			return result;
+		}
+
+		template<typename T>
+		inline split_matrix<T>& split_matrix<T>::operator +=(const split_matrix& oth)
+		{
+			assert(size() == oth.size());
+			simd::add(re.data(), oth.re.data(), re.size());
+			simd::add(im.data(), oth.im.data(), im.size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_matrix<T>& split_matrix<T>::operator -=(const split_matrix& oth)
+		{
+			assert(size() == oth.size());
+			simd::sub(re.data(), oth.re.data(), re.size());
+			simd::sub(im.data(), oth.im.data(), im.size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_matrix<T>& split_matrix<T>::operator *=(value_type value)
+		{
+			simd::cscale(re.data(), im.data(), value.real, value.imag, re.size());
+			return *this;
+		}
+
+		template<typename T>
+		inline split_matrix<T> split_matrix<T>::operator +(const split_matrix& oth) const
+		{
+			split_matrix result(*this);
+			return result += oth;
+		}
+
+		template<typename T>
+		inline split_matrix<T> split_matrix<T>::operator -(const split_matrix& oth) const
+		{
+			split_matrix result(*this);
+			return result -= oth;
+		}
+
+		template<typename T>
+		inline split_matrix<T> split_matrix<T>::operator *(value_type value) const
+		{
+			split_matrix result(*this);
+			return result *= value;
+		}
+
+		template<typename T>
+		inline split_matrix<T> split_matrix<T>::operator *(const split_matrix& oth) const
+		{
+			// Cr = Ar Br - Ai Bi, Ci = Ar Bi + Ai Br
+			assert(ncols == oth.nrows);
+			auto m = nrows;
+			auto n = oth.ncols;
+			auto k = ncols;
+			split_matrix result(m, n);
+			if (m == 0 || n == 0 || k == 0)
+				return result;
+
+			kernel::gemm<T>(m, n, k, T(1), re.data(), k, oth.re.data(), n, T(0), result.re.data(), n);
+			kernel::gemm<T>(m, n, k, T(-1), im.data(), k, oth.im.data(), n, T(1), result.re.data(), n);
+			kernel::gemm<T>(m, n, k, T(1), re.data(), k, oth.im.data(), n, T(0), result.im.data(), n);
+			kernel::gemm<T>(m, n, k, T(1), im.data(), k, oth.re.data(), n, T(1), result.im.data(), n);
+			return result;
+		}
+
+		template<typename T>
+		inline split_vector<T> split_matrix<T>::operator *(const split_vector<T>& vect) const
+		{
+			assert(ncols == vect.size());
+			split_vector<T> result(nrows);
+			parallel::parallel_for(0, nrows, 4 * nrows * ncols, [&](uint128_t lo, uint128_t hi)
+			{
+				for (auto i = lo; i < hi; i++)
+				{
+					const T* ar = re.data() + i * ncols;
+					const T* ai = im.data() + i * ncols;
+					result.re[i] = simd::dot(ar, vect.re.data(), ncols) - simd::dot(ai, vect.im.data(), ncols);
+					result.im[i] = simd::dot(ar, vect.im.data(), ncols) + simd::dot(ai, vect.re.data(), ncols);
+				}
+			});
+			return result;
+		}
+	}
+}
@@ -0,0 +1,533 @@
+#include "../include/structured.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// a(i, :) *= d[i], rows are split between threads
+		template<typename T>
+		inline void scale_rows(uint128_t m, uint128_t n, const T* d, T* a, uint128_t lda)
+		{
+			parallel::parallel_for(0, m, m * n, [&](uint128_t lo, uint128_t hi)
+			{
+				for (auto i = lo; i < hi; i++)
+				{
+					T* row = a + i * lda;
+					T alpha = d[i];
+					for (uint128_t j = 0; j < n; j++)
+						row[j] *= alpha;
+				}
+			});
+		}
+
+		// a(:, j) *= d[j], every row is multiplied by d elementwise
+		template<typename T>
+		inline void scale_cols(uint128_t m, uint128_t n, const T* d, T* a, uint128_t lda)
+		{
+			parallel::parallel_for(0, m, m * n, [&](uint128_t lo, uint128_t hi)
+			{
+				for (auto i = lo; i < hi; i++)
+				{
+					T* row = a + i * lda;
+					for (uint128_t j = 0; j < n; j++)
+						row[j] *= d[j];
+				}
+			});
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline diagonal_matrix<T>::diagonal_matrix(uint128_t n, T value) :
+			values(n, value)
+		{
+		}
+
+		template<typename T>
+		inline diagonal_matrix<T>::diagonal_matrix(const vector_base<T>& values) :
+			values(values)
+		{
+		}
+
+		template<typename T>
+		inline uint128_t diagonal_matrix<T>::rows() const
+		{
+			return values.size();
+		}
+
+		template<typename T>
+		inline uint128_t diagonal_matrix<T>::cols() const
+		{
+			return values.size();
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> diagonal_matrix<T>::size() const
+		{
+			return std::make_pair(rows(), cols());
+		}
+
+		template<typename T>
+		inline T diagonal_matrix<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			assert(i < rows() && j < cols());
+			return i == j ? values.base[i] : T(0);
+		}
+
+		template<typename T>
+		inline T diagonal_matrix<T>::det() const
+		{
+			T result = 1;
+			for (auto& value : values.base)
+				result *= value;
+			return result;
+		}
+
+		template<typename T>
+		inline diagonal_matrix<T> diagonal_matrix<T>::inversed() const
+		{
+			diagonal_matrix<T> result(*this);
+			for (auto& value : result.values.base)
+			{
+				assert(value != T(0));
+				value = T(1) / value;
+			}
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T> diagonal_matrix<T>::solve(const vector_base<T>& b) const
+		{
+			assert(b.size() == rows());
+			vector_base<T> x(b);
+			for (uint128_t i = 0; i < rows(); i++)
+			{
+				assert(values.base[i] != T(0));
+				x.base[i] /= values.base[i];
+			}
+			return x;
+		}
+
+		template<typename T>
+		inline matrix_base<T> diagonal_matrix<T>::solve(const matrix_base<T>& b) const
+		{
+			assert(b.rows() == rows());
+			matrix_base<T> x(b);
+			auto inv = inversed();
+			kernel::scale_rows(x.rows(), x.cols(), inv.values.base.data(), x.data(), x.ld);
+			return x;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_base<V> diagonal_matrix<T>::dense() const
+		{
+			auto n = rows();
+			matrix_base<V> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+				result(i, i) = values.base[i];
+			return result;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline diagonal_matrix<T>::operator matrix_base<V>() const
+		{
+			return dense<V>();
+		}
+
+		template<typename T>
+		inline scalar_matrix<T>::scalar_matrix(uint128_t n, T value) :
+			n(n),
+			value(value)
+		{
+		}
+
+		template<typename T>
+		inline uint128_t scalar_matrix<T>::rows() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline uint128_t scalar_matrix<T>::cols() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> scalar_matrix<T>::size() const
+		{
+			return std::make_pair(n, n);
+		}
+
+		template<typename T>
+		inline T scalar_matrix<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			assert(i < n && j < n);
+			return i == j ? value : T(0);
+		}
+
+		template<typename T>
+		inline T scalar_matrix<T>::det() const
+		{
+			T result = 1;
+			for (uint128_t i = 0; i < n; i++)
+				result *= value;
+			return result;
+		}
+
+		template<typename T>
+		inline scalar_matrix<T> scalar_matrix<T>::inversed() const
+		{
+			assert(value != T(0));
+			return scalar_matrix<T>(n, T(1) / value);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_base<V> scalar_matrix<T>::dense() const
+		{
+			matrix_base<V> result(n, n);
+			for (uint128_t i = 0; i < n; i++)
+				result(i, i) = value;
+			return result;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline scalar_matrix<T>::operator matrix_base<V>() const
+		{
+			return dense<V>();
+		}
+
+		template<typename T>
+		inline zero_matrix<T>::zero_matrix(uint128_t m, uint128_t n) :
+			nrows(m),
+			ncols(n)
+		{
+		}
+
+		template<typename T>
+		inline uint128_t zero_matrix<T>::rows() const
+		{
+			return nrows;
+		}
+
+		template<typename T>
+		inline uint128_t zero_matrix<T>::cols() const
+		{
+			return ncols;
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> zero_matrix<T>::size() const
+		{
+			return std::make_pair(nrows, ncols);
+		}
+
+		template<typename T>
+		inline T zero_matrix<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			assert(i < nrows && j < ncols);
+			return T(0);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_base<V> zero_matrix<T>::dense() const
+		{
+			return matrix_base<V>(nrows, ncols);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline zero_matrix<T>::operator matrix_base<V>() const
+		{
+			return dense<V>();
+		}
+
+		template<typename T>
+		inline vector_base<T> operator*(const diagonal_matrix<T>& diag, const vector_base<T>& vect)
+		{
+			assert(diag.cols() == vect.size());
+			vector_base<T> result(vect);
+			for (uint128_t i = 0; i < result.size(); i++)
+				result.base[i] *= diag.values.base[i];
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator*(const diagonal_matrix<T>& diag, const matrix_base<T>& matr)
+		{
+			matrix_base<T> result(matr);
+			return scale_rows(result, diag.values);
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator*(const matrix_base<T>& matr, const diagonal_matrix<T>& diag)
+		{
+			matrix_base<T> result(matr);
+			return scale_cols(result, diag.values);
+		}
+
+		template<typename T>
+		inline diagonal_matrix<T> operator*(const diagonal_matrix<T>& lhs, const diagonal_matrix<T>& rhs)
+		{
+			return diagonal_matrix<T>(lhs * rhs.values);
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const matrix_base<T>& matr, const diagonal_matrix<T>& diag)
+		{
+			assert(matr.size() == diag.size());
+			matrix_base<T> result(matr);
+			for (uint128_t i = 0; i < diag.rows(); i++)
+				result(i, i) += diag.values.base[i];
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const diagonal_matrix<T>& diag, const matrix_base<T>& matr)
+		{
+			return matr + diag;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const matrix_base<T>& matr, const diagonal_matrix<T>& diag)
+		{
+			assert(matr.size() == diag.size());
+			matrix_base<T> result(matr);
+			for (uint128_t i = 0; i < diag.rows(); i++)
+				result(i, i) -= diag.values.base[i];
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const diagonal_matrix<T>& diag, const matrix_base<T>& matr)
+		{
+			assert(matr.size() == diag.size());
+			matrix_base<T> result(matr);
+			result *= T(-1);
+			for (uint128_t i = 0; i < diag.rows(); i++)
+				result(i, i) += diag.values.base[i];
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T> operator*(const scalar_matrix<T>& scal, const vector_base<T>& vect)
+		{
+			assert(scal.cols() == vect.size());
+			vector_base<T> result(vect);
+			result *= scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator*(const scalar_matrix<T>& scal, const matrix_base<T>& matr)
+		{
+			assert(scal.cols() == matr.rows());
+			matrix_base<T> result(matr);
+			result *= scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator*(const matrix_base<T>& matr, const scalar_matrix<T>& scal)
+		{
+			assert(matr.cols() == scal.rows());
+			matrix_base<T> result(matr);
+			result *= scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline diagonal_matrix<T> operator*(const scalar_matrix<T>& scal, const diagonal_matrix<T>& diag)
+		{
+			assert(scal.cols() == diag.rows());
+			diagonal_matrix<T> result(diag);
+			result.values *= scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline diagonal_matrix<T> operator*(const diagonal_matrix<T>& diag, const scalar_matrix<T>& scal)
+		{
+			return scal * diag;
+		}
+
+		template<typename T>
+		inline scalar_matrix<T> operator*(const scalar_matrix<T>& lhs, const scalar_matrix<T>& rhs)
+		{
+			assert(lhs.cols() == rhs.rows());
+			return scalar_matrix<T>(lhs.rows(), lhs.value * rhs.value);
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const matrix_base<T>& matr, const scalar_matrix<T>& scal)
+		{
+			assert(matr.size() == scal.size());
+			matrix_base<T> result(matr);
+			for (uint128_t i = 0; i < scal.rows(); i++)
+				result(i, i) += scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const scalar_matrix<T>& scal, const matrix_base<T>& matr)
+		{
+			return matr + scal;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const matrix_base<T>& matr, const scalar_matrix<T>& scal)
+		{
+			return matr + scalar_matrix<T>(scal.rows(), -scal.value);
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const scalar_matrix<T>& scal, const matrix_base<T>& matr)
+		{
+			assert(matr.size() == scal.size());
+			matrix_base<T> result(matr);
+			result *= T(-1);
+			for (uint128_t i = 0; i < scal.rows(); i++)
+				result(i, i) += scal.value;
+			return result;
+		}
+
+		template<typename T>
+		inline vector_base<T> operator*(const zero_matrix<T>& zero, const vector_base<T>& vect)
+		{
+			assert(zero.cols() == vect.size());
+			return vector_base<T>(zero.rows());
+		}
+
+		template<typename T>
+		inline zero_matrix<T> operator*(const zero_matrix<T>& zero, const matrix_base<T>& matr)
+		{
+			assert(zero.cols() == matr.rows());
+			return zero_matrix<T>(zero.rows(), matr.cols());
+		}
+
+		template<typename T>
+		inline zero_matrix<T> operator*(const matrix_base<T>& matr, const zero_matrix<T>& zero)
+		{
+			assert(matr.cols() == zero.rows());
+			return zero_matrix<T>(matr.rows(), zero.cols());
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const matrix_base<T>& matr, const zero_matrix<T>& zero)
+		{
+			assert(matr.size() == zero.size());
+			return matr;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator+(const zero_matrix<T>& zero, const matrix_base<T>& matr)
+		{
+			assert(matr.size() == zero.size());
+			return matr;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const matrix_base<T>& matr, const zero_matrix<T>& zero)
+		{
+			assert(matr.size() == zero.size());
+			return matr;
+		}
+
+		template<typename T>
+		inline matrix_base<T> operator-(const zero_matrix<T>& zero, const matrix_base<T>& matr)
+		{
+			assert(matr.size() == zero.size());
+			matrix_base<T> result(matr);
+			result *= T(-1);
+			return result;
+		}
+	}
+
+	template<typename T>
+	inline base_type::scalar_matrix<T> identity_matrix(uint128_t n)
+	{
+		return base_type::scalar_matrix<T>(n, T(1));
+	}
+
+	template<typename T>
+	inline base_type::zero_matrix<T> zero_matrix(uint128_t m, uint128_t n)
+	{
+		return base_type::zero_matrix<T>(m, n);
+	}
+
+	template<typename T>
+	inline base_type::scalar_matrix<T> diagonal(const uint128_t& n, const T& value)
+	{
+		return base_type::scalar_matrix<T>(n, value);
+	}
+
+	template<typename T>
+	inline base_type::diagonal_matrix<T> diagonal(const base_type::vector_base<T>& values)
+	{
+		return base_type::diagonal_matrix<T>(values);
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T>& scale_rows(base_type::matrix_base<T>& matr, const base_type::vector_base<T>& d)
+	{
+		assert(matr.rows() == d.size());
+		kernel::scale_rows(matr.rows(), matr.cols(), d.base.data(), matr.data(), matr.ld);
+		return matr;
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T>& scale_cols(base_type::matrix_base<T>& matr, const base_type::vector_base<T>& d)
+	{
+		assert(matr.cols() == d.size());
+		kernel::scale_cols(matr.rows(), matr.cols(), d.base.data(), matr.data(), matr.ld);
+		return matr;
+	}
+
+	template<typename T>
+	inline base_type::vector_base<T> solve(const base_type::diagonal_matrix<T>& matr, const base_type::vector_base<T>& b)
+	{
+		return matr.solve(b);
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> solve(const base_type::diagonal_matrix<T>& matr, const base_type::matrix_base<T>& b)
+	{
+		return matr.solve(b);
+	}
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::diagonal_matrix<T>& matrix)
+{
+	auto n = matrix.rows();
+	for (nm::uint128_t i = 0; i < n; i++)
+	{
+		for (nm::uint128_t j = 0; j < n; j++)
+			out << "\t" << matrix(i, j);
+		out << "\n";
+	}
+	out << typeid(matrix).name() << "\n";
+	return out;
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::scalar_matrix<T>& matrix)
+{
+	out << matrix.value << " * E(" << matrix.rows() << ")\n";
+	out << typeid(matrix).name() << "\n";
+	return out;
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::zero_matrix<T>& matrix)
+{
+	out << "O(" << matrix.rows() << ", " << matrix.cols() << ")\n";
+	out << typeid(matrix).name() << "\n";
+	return out;
+}
@@ -0,0 +1,492 @@
+#include "../include/svd.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// H^H [alpha, x] = [beta, 0], H = I - tau v v^H, v = [1, x * scale]; returns real beta
+		template<typename T>
+		inline typing::real_type_t<T> reflector(T alpha, typing::real_type_t<T> xnorm2, T& tau, T& scale)
+		{
+			using R = typing::real_type_t<T>;
+			R alpha_re = nm::real(alpha);
+			if (xnorm2 == 0 && alpha == T(alpha_re))
+			{
+				tau = 0;
+				scale = 1;
+				return alpha_re;
+			}
+
+			R beta = std::sqrt(nm::real(alpha * nm::conj(alpha)) + xnorm2);
+			if (alpha_re >= 0)
+				beta = -beta;
+			tau = (T(beta) - alpha) / T(beta);
+			scale = T(1) / (alpha - T(beta));
+			return beta;
+		}
+
+		// Q^H A P = B for m x n A, m >= n, B is real upper bidiagonal (d - diagonal, e - superdiagonal);
+		// left reflector j is stored in column j below the diagonal (Q = H_0 ... H_{n-1}),
+		// right reflector j in row j right of the superdiagonal (P = G_0 ... G_{n-2})
+		template<typename T>
+		inline void bidiagonal(uint128_t m, uint128_t n, T* a, uint128_t ld,
+			typing::real_type_t<T>* d, typing::real_type_t<T>* e, T* tauq, T* taup)
+		{
+			using R = typing::real_type_t<T>;
+
+			std::vector<T> u(n), cu(n);
+			for (uint128_t j = 0; j < n; j++)
+			{
+				auto rest = n - j - 1;
+				T* aj = a + j * ld;
+
+				// left reflector from column j
+				R xnorm2 = 0;
+				for (auto i = j + 1; i < m; i++)
+					xnorm2 += nm::real(nm::conj(a[i * ld + j]) * a[i * ld + j]);
+				T scale;
+				d[j] = reflector(aj[j], xnorm2, tauq[j], scale);
+				aj[j] = d[j];
+				for (auto i = j + 1; i < m; i++)
+					a[i * ld + j] *= scale;
+
+				if (rest == 0)
+					break;
+
+				// w = v^H A2, row j is updated at once, the rest of A2 waits for the fused pass
+				T ct = nm::conj(tauq[j]);
+				memory::vector<T> w;
+				if (tauq[j] != T(0))
+				{
+					w = reduce_rows<T>(j + 1, m, rest, (m - j) * rest, [&](uint128_t i, T* acc)
+					{
+						row_axpy(rest, nm::conj(a[i * ld + j]), a + i * ld + j + 1, acc);
+					});
+					for (uint128_t c = 0; c < rest; c++)
+					{
+						w[c] += aj[j + 1 + c];
+						aj[j + 1 + c] -= ct * w[c];
+					}
+				}
+
+				// right reflector from row j: x H = beta e_1 for H^H x^H = beta e_1
+				xnorm2 = 0;
+				for (auto c = j + 2; c < n; c++)
+					xnorm2 += nm::real(nm::conj(aj[c]) * aj[c]);
+				e[j] = reflector(nm::conj(aj[j + 1]), xnorm2, taup[j], scale);
+				aj[j + 1] = e[j];
+				u[0] = cu[0] = 1;
+				for (auto c = j + 2; c < n; c++)
+				{
+					aj[c] = nm::conj(aj[c]) * scale;
+					u[c - j - 1] = aj[c];
+					cu[c - j - 1] = nm::conj(aj[c]);
+				}
+
+				// one pass over the rows below: A2 -= v w (left), then A2 -= tau (A2 u) u^H (right)
+				T tp = taup[j];
+				parallel::parallel_for(j + 1, m, 2 * (m - j) * rest, [&](uint128_t lo, uint128_t hi)
+				{
+					for (auto i = lo; i < hi; i++)
+					{
+						T* row = a + i * ld + j + 1;
+						if (!w.empty())
+							row_axpy(rest, -ct * a[i * ld + j], w.data(), row);
+						if (tp != T(0))
+							row_axpy(rest, -tp * row_dot(rest, row, u.data()), cu.data(), row);
+					}
+				});
+			}
+		}
+
+		// x = c x + s y, y = c y - s x for two rows of z
+		template<typename R>
+		inline void rotate_pair(R* x, R* y, R c, R s, uint128_t nc)
+		{
+			for (uint128_t j = 0; j < nc; j++)
+			{
+				R t = x[j];
+				x[j] = c * t + s * y[j];
+				y[j] = c * y[j] - s * t;
+			}
+		}
+
+		// implicit QR iteration with Wilkinson shift for upper bidiagonal (d, e), B = U S V^T;
+		// left / right rotations are accumulated in the rows of ut (U^T) / vt (V^T) if they are not null,
+		// d may end up negative; returns false if it does not converge
+		template<typename R>
+		inline bool bidiagonal_qr(uint128_t n, R* d, R* e, R* ut, uint128_t ldu, uint128_t nu, R* vt, uint128_t ldv, uint128_t nv)
+		{
+			if (n < 2)
+				return true;
+
+			R norm = 0;
+			for (uint128_t i = 0; i < n; i++)
+				norm = std::max(norm, nm::abs(d[i]));
+			for (uint128_t i = 0; i + 1 < n; i++)
+				norm = std::max(norm, nm::abs(e[i]));
+			if (norm == 0)
+				return true;
+
+			const R eps = std::numeric_limits<R>::epsilon();
+			const R thresh = eps * norm;
+			auto small = [&](uint128_t i)
+			{
+				R ei = nm::abs(e[i]);
+				return ei <= thresh || ei <= eps * (nm::abs(d[i]) + nm::abs(d[i + 1]));
+			};
+
+			std::vector<R> uc(n), us(n), vc(n), vs(n);
+			uint128_t sweeps = 0;
+			uint128_t end = n - 1;
+			while (end > 0)
+			{
+				if (small(end - 1))
+				{
+					e[end - 1] = 0;
+					end--;
+					continue;
+				}
+				if (sweeps++ >= 30 * n)
+					return false;
+
+				// unreduced block [start, end]
+				auto start = end - 1;
+				while (start > 0 && !small(start - 1))
+					start--;
+				if (start > 0)
+					e[start - 1] = 0;
+
+				// zero on the diagonal: its superdiagonal is chased out, the block splits
+				auto zero = end + 1;
+				for (auto i = start; i <= end && zero > end; i++)
+					if (nm::abs(d[i]) <= thresh)
+						zero = i;
+				if (zero <= end)
+				{
+					d[zero] = 0;
+					if (zero < end)
+					{
+						// left rotations of rows (zero, k), k = zero + 1 ... end
+						R f = e[zero];
+						e[zero] = 0;
+						for (auto k = zero + 1; k <= end; k++)
+						{
+							R r = std::hypot(d[k], f);
+							R c = d[k] / r;
+							R s = f / r;
+							d[k] = r;
+							if (k < end)
+							{
+								f = -s * e[k];
+								e[k] *= c;
+							}
+							if (ut)
+								rotate_pair(ut + k * ldu, ut + zero * ldu, c, s, nu);
+						}
+					}
+					else
+					{
+						// right rotations of columns (k, end), k = end - 1 ... start
+						R f = e[end - 1];
+						e[end - 1] = 0;
+						for (auto k = end; k-- > start;)
+						{
+							R r = std::hypot(d[k], f);
+							R c = d[k] / r;
+							R s = f / r;
+							d[k] = r;
+							if (k > start)
+							{
+								f = -s * e[k - 1];
+								e[k - 1] *= c;
+							}
+							if (vt)
+								rotate_pair(vt + k * ldv, vt + end * ldv, c, s, nv);
+						}
+					}
+					continue;
+				}
+
+				// shift is the eigenvalue of the trailing 2 x 2 block of B^T B closer to its last element
+				R t11 = d[end - 1] * d[end - 1] + (end - 1 > start ? e[end - 2] * e[end - 2] : R(0));
+				R t12 = d[end - 1] * e[end - 1];
+				R t22 = d[end] * d[end] + e[end - 1] * e[end - 1];
+				R delta = (t11 - t22) / 2;
+				R mu = t22 - t12 * t12 / (delta + std::copysign(std::hypot(delta, t12), delta));
+
+				// chase the bulge down the block: right rotation of columns (k, k + 1), then left of rows
+				R y = d[start] * d[start] - mu;
+				R z = d[start] * e[start];
+				for (auto k = start; k < end; k++)
+				{
+					R r = std::hypot(y, z);
+					R c = r == 0 ? R(1) : y / r;
+					R s = r == 0 ? R(0) : -z / r;
+					if (k > start)
+						e[k - 1] = r;
+					R dk = d[k];
+					R ek = e[k];
+					d[k] = c * dk - s * ek;
+					e[k] = s * dk + c * ek;
+					z = -s * d[k + 1];
+					d[k + 1] *= c;
+					vc[k - start] = c;
+					vs[k - start] = s;
+
+					y = d[k];
+					r = std::hypot(y, z);
+					c = r == 0 ? R(1) : y / r;
+					s = r == 0 ? R(0) : -z / r;
+					d[k] = r;
+					ek = e[k];
+					e[k] = c * ek - s * d[k + 1];
+					d[k + 1] = s * ek + c * d[k + 1];
+					if (k + 1 < end)
+					{
+						z = -s * e[k + 1];
+						e[k + 1] *= c;
+						y = e[k];
+					}
+					uc[k - start] = c;
+					us[k - start] = s;
+				}
+				if (vt)
+					rotate_rows(start, end - start, vc.data(), vs.data(), vt, ldv, nv);
+				if (ut)
+					rotate_rows(start, end - start, uc.data(), us.data(), ut, ldu, nu);
+			}
+			return true;
+		}
+	}
+
+	namespace base_type
+	{
+		template<typename T>
+		inline svd_base<T>::svd_base(const matrix_base<T>& matr, svd_mode_t mode) :
+			values(std::min(matr.rows(), matr.cols())),
+			nrows(matr.rows()),
+			ncols(matr.cols()),
+			converged(true)
+		{
+			auto m = nrows;
+			auto n = ncols;
+			bool vectors = mode != svd_mode_t::values;
+
+			// wide: A^H = V S U^H
+			if (m < n)
+			{
+				matrix_base<T> adjoint(n, m);
+				for (uint128_t i = 0; i < m; i++)
+					for (uint128_t j = 0; j < n; j++)
+						adjoint(j, i) = nm::conj(matr(i, j));
+
+				svd_base<T> other(adjoint, mode);
+				values = std::move(other.values);
+				u = std::move(other.v);
+				v = std::move(other.u);
+				converged = other.converged;
+				return;
+			}
+			if (n == 0)
+				return;
+
+			// tall: A = Q R, only R is bidiagonalized
+			if (m >= 2 * n)
+			{
+				qr_base<T> f(matr);
+				svd_base<T> inner(f.r(), vectors ? svd_mode_t::thin : svd_mode_t::values);
+				values = std::move(inner.values);
+				converged = inner.converged;
+				if (!vectors)
+					return;
+
+				u = matrix_base<T>(m, mode == svd_mode_t::full ? m : n);
+				for (uint128_t i = 0; i < n; i++)
+					std::copy_n(inner.u.data() + i * inner.u.ld, n, u.data() + i * u.ld);
+				for (auto i = n; i < u.cols(); i++)
+					u(i, i) = 1;
+				f.apply_q(u);
+				v = std::move(inner.v);
+				return;
+			}
+
+			matrix_base<T> a(matr);
+			std::vector<real_t> e(n);
+			std::vector<T> tauq(n), taup(n);
+			real_t* d = values.base.data();
+			kernel::bidiagonal(m, n, a.data(), a.ld, d, e.data(), tauq.data(), taup.data());
+
+			if (!vectors)
+			{
+				converged = kernel::bidiagonal_qr<real_t>(n, d, e.data(), nullptr, 0, 0, nullptr, 0, 0);
+				for (uint128_t i = 0; i < n; i++)
+					d[i] = nm::abs(d[i]);
+				std::sort(values.base.begin(), values.base.end(), std::greater<real_t>());
+				return;
+			}
+
+			// B = U_B diag(d) V_B^T, U_B^T and V_B^T are accumulated by rows
+			matrix_base<real_t> ut(n, n), vt(n, n);
+			ut.fill_diagonal(1);
+			vt.fill_diagonal(1);
+			converged = kernel::bidiagonal_qr<real_t>(n, d, e.data(), ut.data(), ut.ld, n, vt.data(), vt.ld, n);
+			for (uint128_t i = 0; i < n; i++)
+			{
+				if (d[i] < 0)
+				{
+					d[i] = -d[i];
+					for (uint128_t j = 0; j < n; j++)
+						vt(i, j) = -vt(i, j);
+				}
+			}
+
+			std::vector<uint128_t> order(n);
+			for (uint128_t i = 0; i < n; i++)
+				order[i] = i;
+			std::sort(order.begin(), order.end(), [&](uint128_t x, uint128_t y) { return d[x] > d[y]; });
+
+			// U = Q [U_B; 0], V = P V_B, columns sorted by singular value
+			u = matrix_base<T>(m, mode == svd_mode_t::full ? m : n);
+			v = matrix_base<T>(n, n);
+			std::vector<real_t> sorted(n);
+			for (uint128_t j = 0; j < n; j++)
+			{
+				sorted[j] = d[order[j]];
+				const real_t* urow = ut.data() + order[j] * ut.ld;
+				const real_t* vrow = vt.data() + order[j] * vt.ld;
+				for (uint128_t i = 0; i < n; i++)
+				{
+					u(i, j) = urow[i];
+					v(i, j) = vrow[i];
+				}
+			}
+			for (auto i = n; i < u.cols(); i++)
+				u(i, i) = 1;
+			std::copy(sorted.begin(), sorted.end(), values.base.begin());
+			kernel::householder_apply(false, m, n, a.data(), a.ld, tauq.data(), u.data(), u.ld, u.cols());
+
+			// right reflectors are stored by rows, householder_apply expects columns
+			if (n > 1)
+			{
+				matrix_base<T> p(n, n);
+				for (uint128_t j = 0; j + 2 < n; j++)
+					for (auto i = j + 2; i < n; i++)
+						p(i, j) = a(j, i);
+				kernel::householder_apply(false, n - 1, n - 1, p.data() + p.ld, p.ld, taup.data(), v.data() + v.ld, v.ld, n);
+			}
+		}
+
+		template<typename T>
+		inline uint128_t svd_base<T>::rows() const
+		{
+			return nrows;
+		}
+
+		template<typename T>
+		inline uint128_t svd_base<T>::cols() const
+		{
+			return ncols;
+		}
+
+		template<typename T>
+		inline bool svd_base<T>::is_converged() const
+		{
+			return converged;
+		}
+
+		template<typename T>
+		inline typename svd_base<T>::real_t svd_base<T>::tolerance() const
+		{
+			return values.size() ? real_t(std::max(nrows, ncols)) * std::numeric_limits<real_t>::epsilon() * values[0] : real_t(0);
+		}
+
+		template<typename T>
+		inline uint128_t svd_base<T>::rank() const
+		{
+			return rank(tolerance());
+		}
+
+		template<typename T>
+		inline uint128_t svd_base<T>::rank(real_t tolerance) const
+		{
+			uint128_t result = 0;
+			while (result < values.size() && values[result] > tolerance)
+				result++;
+			return result;
+		}
+
+		template<typename T>
+		inline typename svd_base<T>::real_t svd_base<T>::cond() const
+		{
+			if (values.size() == 0)
+				return 0;
+			auto smin = values[values.size() - 1];
+			return smin == 0 ? std::numeric_limits<real_t>::infinity() : values[0] / smin;
+		}
+
+		template<typename T>
+		inline typename svd_base<T>::real_t svd_base<T>::norm2() const
+		{
+			return values.size() ? values[0] : real_t(0);
+		}
+
+		template<typename T>
+		inline matrix_base<T> svd_base<T>::pinv() const
+		{
+			return pinv(tolerance());
+		}
+
+		template<typename T>
+		inline matrix_base<T> svd_base<T>::pinv(real_t tolerance) const
+		{
+			assert(u.rows() == nrows && v.rows() == ncols && "pinv needs singular vectors");
+
+			// A+ = V_r diag(1 / s_r) U_r^H, only the first r = rank columns take part
+			auto r = rank(tolerance);
+			matrix_base<T> vs(ncols, r);
+			matrix_base<T> ur(r, nrows);
+			for (uint128_t i = 0; i < ncols; i++)
+				for (uint128_t j = 0; j < r; j++)
+					vs(i, j) = v(i, j) / T(values[j]);
+			for (uint128_t j = 0; j < r; j++)
+				for (uint128_t i = 0; i < nrows; i++)
+					ur(j, i) = nm::conj(u(i, j));
+
+			matrix_base<T> result(ncols, nrows);
+			if (r)
+				kernel::gemm<T>(ncols, nrows, r, T(1), vs.data(), vs.ld, ur.data(), ur.ld, T(0), result.data(), result.ld);
+			return result;
+		}
+	}
+
+	template<typename T>
+	inline base_type::svd_base<T> svd(const base_type::matrix_base<T>& matr, svd_mode_t mode)
+	{
+		return base_type::svd_base<T>(matr, mode);
+	}
+
+	template<typename T>
+	inline base_type::vector_base<typing::real_type_t<T>> svdvals(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::svd_base<T>(matr, svd_mode_t::values).values;
+	}
+
+	template<typename T>
+	inline base_type::matrix_base<T> pinv(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::svd_base<T>(matr, svd_mode_t::thin).pinv();
+	}
+
+	template<typename T>
+	inline uint128_t rank(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::svd_base<T>(matr, svd_mode_t::values).rank();
+	}
+
+	template<typename T>
+	inline typing::real_type_t<T> cond(const base_type::matrix_base<T>& matr)
+	{
+		return base_type::svd_base<T>(matr, svd_mode_t::values).cond();
+	}
+}
@@ -0,0 +1,99 @@
+#include "../include/transpose.hpp"
+
+namespace nm
+{
+	namespace kernel
+	{
+		// halves the larger dimension, parts stay multiples of TRANSPOSE_BLOCK
+		template<typename T>
+		inline void transpose_recursive(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb)
+		{
+			if (m <= TRANSPOSE_BLOCK && n <= TRANSPOSE_BLOCK)
+			{
+				simd::transpose(m, n, a, lda, b, ldb);
+				return;
+			}
+
+			if (m >= n)
+			{
+				uint128_t h = (m / 2 + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK * TRANSPOSE_BLOCK;
+				transpose_recursive(h, n, a, lda, b, ldb);
+				transpose_recursive(m - h, n, a + h * lda, lda, b + h, ldb);
+			}
+			else
+			{
+				uint128_t h = (n / 2 + TRANSPOSE_BLOCK - 1) / TRANSPOSE_BLOCK * TRANSPOSE_BLOCK;
+				transpose_recursive(m, h, a, lda, b, ldb);
+				transpose_recursive(m, n - h, a + h, lda, b + h * ldb, ldb);
+			}
+		}
+
+		template<typename T>
+		inline void transpose(uint128_t m, uint128_t n, const T* a, uint128_t lda, T* b, uint128_t ldb)
+		{
+			// rows of a are columns of b, so the ranges of workers do not overlap
+			parallel::parallel_for(0, m, m * n, [&](uint128_t lo, uint128_t hi)
+			{
+				transpose_recursive(hi - lo, n, a + lo * lda, lda, b + lo, ldb);
+			});
+		}
+
+		template<typename T>
+		inline void transpose_square(uint128_t n, T* a, uint128_t lda)
+		{
+			constexpr auto B = TRANSPOSE_BLOCK;
+			uint128_t blocks = (n + B - 1) / B;
+
+			// block row i swaps with block column i, pairs of different rows are disjoint
+			parallel::parallel_for(0, blocks, n * n / 2, [&](uint128_t lo, uint128_t hi)
+			{
+				memory::vector<T> work(B * B);
+				for (uint128_t i = lo * B; i < std::min(hi * B, n); i += B)
+				{
+					uint128_t bi = std::min(B, n - i);
+					T* diag = a + i * lda + i;
+					simd::transpose(bi, bi, diag, lda, work.data(), bi);
+					for (uint128_t r = 0; r < bi; r++)
+						std::copy_n(work.data() + r * bi, bi, diag + r * lda);
+
+					for (uint128_t j = i + B; j < n; j += B)
+					{
+						uint128_t bj = std::min(B, n - j);
+						T* upper = a + i * lda + j;		// bi x bj
+						T* lower = a + j * lda + i;		// bj x bi
+						simd::transpose(bi, bj, upper, lda, work.data(), bi);
+						simd::transpose(bj, bi, lower, lda, upper, lda);
+						for (uint128_t r = 0; r < bj; r++)
+							std::copy_n(work.data() + r * bi, bi, lower + r * lda);
+					}
+				}
+			});
+		}
+
+		template<typename T>
+		inline void transpose_cycles(uint128_t m, uint128_t n, T* a)
+		{
+			if (m <= 1 || n <= 1)
+				return;
+
+			// element (i, j) at p = i * n + j goes to (j, i) at j * m + i = p * m mod last,
+			// the first and the last elements stay
+			uint128_t last = m * n - 1;
+			std::vector<bool> moved(last);
+			for (uint128_t start = 1; start < last; start++)
+			{
+				if (moved[start])
+					continue;
+
+				T carry = a[start];
+				uint128_t p = start;
+				do
+				{
+					p = p * m % last;
+					std::swap(carry, a[p]);
+					moved[p] = true;
+				} while (p != start);
+			}
+		}
+	}
+}
@@ -18,7 +18,7 @@ namespace nm
 
 		template<typename T>
 		inline vector_base<T>::vector_base(const std::vector<T>& stdvect) :
-			base(stdvect)
+			base(stdvect.begin(), stdvect.end())
 		{
 		}
 
@@ -28,9 +28,39 @@ namespace nm
 		{
 		}
 
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline vector_base<T>::vector_base(const vector_expr<L, R, Op>& expr) :
+			base(expr.size())
+		{
+			auto n = size();
+			for (int i = 0; i < n; i++)
+				base[i] = expr[i];
+		}
+
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline vector_base<T>& vector_base<T>::operator=(const vector_expr<L, R, Op>& expr)
+		{
+			if (aliases(storage(*this), expr))
+				return *this = vector_base<T>(expr);
+
+			auto n = expr.size();
+			base.resize(n);
+			for (int i = 0; i < n; i++)
+				base[i] = expr[i];
+			return *this;
+		}
+
 		template<typename T>
 		inline vector_base<T>& vector_base<T>::fill(T value)
 		{
+			if constexpr (typing::is_simd_v<T>)
+			{
+				simd::fill(base.data(), value, size());
+				return *this;
+			}
+
 			for (auto& element : base)
 				element = value;
 			return *this;
@@ -42,6 +72,12 @@ namespace nm
 			return base.size();
 		}
 
+		template<typename T>
+		inline bool vector_base<T>::is_aligned() const
+		{
+			return memory::is_aligned(base.data());
+		}
+
 		template<typename T>
 		inline T& vector_base<T>::operator[](int32_t i)
 		{
@@ -59,16 +95,27 @@ namespace nm
 		}
 
 		template<typename T>
-		inline vector_base<T> vector_base<T>::slice(int32_t beg, int32_t end, uint32_t step) const
+		inline vector_view<T> vector_base<T>::view()
 		{
-			int32_t st = step;
-			auto n = 1 + std::abs(end - beg) / st;
-			if (beg > end)
-				st = -st;
-			vector_base<T> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = (*this)[beg + i * st];
-			return result;
+			return vector_view<T>(base.data(), base.size());
+		}
+
+		template<typename T>
+		inline vector_view<const T> vector_base<T>::view() const
+		{
+			return vector_view<const T>(base.data(), base.size());
+		}
+
+		template<typename T>
+		inline vector_view<T> vector_base<T>::slice(int32_t beg, int32_t end, uint32_t step)
+		{
+			return view().slice(beg, end, step);
+		}
+
+		template<typename T>
+		inline vector_view<const T> vector_base<T>::slice(int32_t beg, int32_t end, uint32_t step) const
+		{
+			return view().slice(beg, end, step);
 		}
 
 		template<typename T>
@@ -99,13 +146,19 @@ namespace nm
 		template<typename T>
 		inline T vector_base<T>::max() const
 		{
-			return *std::max_element(base.begin(), base.end());
+			if constexpr (typing::is_simd_v<T>)
+				return simd::max(base.data(), size());
+			else
+				return *std::max_element(base.begin(), base.end());
 		}
 
 		template<typename T>
 		inline T vector_base<T>::min() const
 		{
-			return *std::min_element(base.begin(), base.end());
+			if constexpr (typing::is_simd_v<T>)
+				return simd::min(base.data(), size());
+			else
+				return *std::min_element(base.begin(), base.end());
 		}
 
 		template<typename T>
@@ -139,7 +192,10 @@ namespace nm
 		template<typename T>
 		inline T vector_base<T>::sum() const
 		{
-			T sumv = NULL;
+			if constexpr (typing::is_simd_v<T>)
+				return simd::sum(base.data(), size());
+
+			T sumv = 0;
 			for (auto& element : base)
 				sumv += element;
 			return sumv;
@@ -148,15 +204,30 @@ namespace nm
 		template<typename T>
 		inline float_t vector_base<T>::abs() const
 		{
-			float_t sumv = NULL;
+			using R = typing::real_type_t<T>;
+			if constexpr (typing::is_simd_v<R>)
+			{
+				// complex_base is a pair of reals, so |z|^2 sums over 2n reals
+				auto data = reinterpret_cast<const R*>(base.data());
+				auto n = size() * (sizeof(T) / sizeof(R));
+				return sqrt(float_t(simd::sumsq(data, n)));
+			}
+
+			float_t sumv = 0;
 			for (auto& element : base)
-				sumv += pow(nm::abs(element), 2);
+			{
+				float_t value = nm::abs(element);
+				sumv += value * value;
+			}
 			return sqrt(sumv);
 		}
 
 		template<typename T>
 		inline T vector_base<T>::norm1() const
 		{
+			if constexpr (typing::is_simd_v<T>)
+				return simd::sumabs(base.data(), size());
+
 			T sumv = 0;
 			for (auto& element : base)
 				sumv += nm::abs(element);
@@ -172,30 +243,26 @@ namespace nm
 		template<typename T>
 		inline T vector_base<T>::normi() const
 		{
-			T amax = nm::abs(base[0]);
+			if constexpr (typing::is_simd_v<T>)
+				return simd::maxabs(base.data(), size());
+
+			typing::real_type_t<T> amax = 0;
 			for (auto& element : base)
-				amax = nm::abs(element);
+				amax = std::max(amax, nm::abs(element));
 			return amax;
 		}
 
-		template<typename T>
-		inline vector_base<T> vector_base<T>::operator-() const
-		{
-			auto n = size();
-			vector_base<T> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = -base[i];
-			return result;
-		}
-
 		template<typename T>
 		template<typename V>
 		inline auto vector_base<T>::dot(const vector_base<V>& oth) const
 		{
-			using TS = typing::conditional_t(typing::is_stronger<T, V>(), T, V);
-			TS product = 0;
+			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
 			auto n = size();
 			assert(n == oth.size());
+			if constexpr (typing::is_simd_v<T> && typing::is_same_v<T, V>)
+				return simd::dot(base.data(), oth.base.data(), n);
+
+			TS product = 0;
 			for (int i = 0; i < n; i++)
 				product += base[i] * oth[i];
 			return product;
@@ -206,7 +273,7 @@ namespace nm
 		inline auto vector_base<T>::cross(const vector_base<V>& oth) const
 		{
 			assert(size() == oth.size() && size() == 3);
-			using TS = typing::conditional_t(typing::is_stronger<T, V>(), T, V);
+			using TS = typing::conditional_t<typing::is_stronger<T, V>::value, T, V>;
 
 			return vector_base<TS>({
 				base[1] * oth[2] - base[2] * oth[1],
@@ -216,137 +283,43 @@ namespace nm
 		}
 
 		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator+(const vector_base<V>& oth) const
+		template<typename E, typing::require<typing::is_vector_operand_v<E>>>
+		inline vector_base<T>& vector_base<T>::operator+=(const E& oth)
 		{
 			auto n = size();
 			assert(n == oth.size());
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] + oth[i];
-			return result;
-		}
+			if (aliases(storage(*this), oth))
+				return *this += owning(oth);
+			if constexpr (typing::is_simd_v<T> && typing::is_same_v<E, vector_base<T>>)
+			{
+				simd::add(base.data(), oth.base.data(), n);
+				return *this;
+			}
 
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator-(const vector_base<V>& oth) const
-		{
-			auto n = size();
-			assert(n == oth.size());
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] - oth[i];
-			return result;
-		}
-
-		template<typename T>
-		inline vector_base<T>& vector_base<T>::operator+=(const vector_base<T>& oth)
-		{
-			auto n = size();
-			assert(n == oth.size());
 			for (int i = 0; i < n; i++)
 				base[i] += oth[i];
 			return *this;
 		}
 
 		template<typename T>
-		inline vector_base<T>& vector_base<T>::operator-=(const vector_base<T>& oth)
+		template<typename E, typing::require<typing::is_vector_operand_v<E>>>
+		inline vector_base<T>& vector_base<T>::operator-=(const E& oth)
 		{
 			auto n = size();
 			assert(n == oth.size());
+			if (aliases(storage(*this), oth))
+				return *this -= owning(oth);
+			if constexpr (typing::is_simd_v<T> && typing::is_same_v<E, vector_base<T>>)
+			{
+				simd::sub(base.data(), oth.base.data(), n);
+				return *this;
+			}
+
 			for (int i = 0; i < n; i++)
 				base[i] -= oth[i];
 			return *this;
 		}
 
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator+(const V& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] + value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator-(const V& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] - value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator*(const V& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = value * base[i];
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator/(const V& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<T>, vector_base<V>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] / value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator+(const complex_base<V>& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<complex_base<T>>, vector_base<complex_base<V>>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] + value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator-(const complex_base<V>& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<complex_base<T>>, vector_base<complex_base<V>>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] - value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator*(const complex_base<V>& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<complex_base<T>>, vector_base<complex_base<V>>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] * value;
-			return result;
-		}
-
-		template<typename T>
-		template<typename V>
-		inline auto vector_base<T>::operator/(const complex_base<V>& value) const
-		{
-			auto n = size();
-			typing::conditional_t<typing::is_stronger<T, V>::value, vector_base<complex_base<T>>, vector_base<complex_base<V>>> result(n);
-			for (int i = 0; i < n; i++)
-				result[i] = base[i] / value;
-			return result;
-		}
-
 		template<typename T>
 		inline vector_base<T>& vector_base<T>::operator+=(const T& value)
 		{
@@ -366,6 +339,12 @@ namespace nm
 		template<typename T>
 		inline vector_base<T>& vector_base<T>::operator*=(const T& value)
 		{
+			if constexpr (typing::is_simd_v<T>)
+			{
+				simd::scale(base.data(), value, size());
+				return *this;
+			}
+
 			for (int i = 0; i < size(); i++)
 				base[i] *= value;
 			return *this;
@@ -388,105 +367,4 @@ inline std::ostream& operator<<(std::ostream& out, const nm::base_type::vector_b
 		out << elem << "\n";
 	out << typeid(vector).name() << "\n";
 	return out;
-}
-
-template<typename T, typename V>
-inline auto operator+(const V& value, const nm::base_type::vector_base<T>& vector)
-{
-	using VT = nm::base_type::vector_base<T>;
-	using VV  = nm::base_type::vector_base<V>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value + vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator-(const V& value, const nm::base_type::vector_base<T>& vector)
-{
-	using VT = nm::base_type::vector_base<T>;
-	using VV = nm::base_type::vector_base<V>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value - vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator*(const V& value, const nm::base_type::vector_base<T>& vector)
-{
-	using VT = nm::base_type::vector_base<T>;
-	using VV = nm::base_type::vector_base<V>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value * vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator/(const V& value, const nm::base_type::vector_base<T>& vector)
-{
-	using VT = nm::base_type::vector_base<T>;
-	using VV = nm::base_type::vector_base<V>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value / vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator+(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using VT = nm::base_type::vector_base<CT>;
-	using VV = nm::base_type::vector_base<CV>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value + vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator-(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using VT = nm::base_type::vector_base<CT>;
-	using VV = nm::base_type::vector_base<CV>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value - vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator*(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using VT = nm::base_type::vector_base<CT>;
-	using VV = nm::base_type::vector_base<CV>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value * vector.base[i];
-	return result;
-}
-
-template<typename T, typename V>
-inline auto operator/(const nm::base_type::complex_base<V>& value, const nm::base_type::vector_base<T>& vector)
-{
-	using CT = nm::base_type::complex_base<T>;
-	using CV = nm::base_type::complex_base<V>;
-	using VT = nm::base_type::vector_base<CT>;
-	using VV = nm::base_type::vector_base<CV>;
-	nm::typing::conditional_t<nm::typing::is_stronger<T, V>::value, VT, VV> result(vector.size());
-
-	for (int i = 0; i < vector.size(); i++)
-		result[i] = value / vector.base[i];
-	return result;
-}
-
+}
\ No newline at end of file
@@ -0,0 +1,501 @@
+#include "../include/view.hpp"
+
+namespace nm
+{
+	namespace base_type
+	{
+		template<typename T>
+		inline vector_view<T>::vector_view(T* ptr, uint128_t n, int128_t step) :
+			base(ptr),
+			n(n),
+			step(step)
+		{
+		}
+
+		template<typename T>
+		template<typename V>
+		inline vector_view<T>::vector_view(const vector_view<V>& oth) :
+			base(oth.base),
+			n(oth.n),
+			step(oth.step)
+		{
+		}
+
+		template<typename T>
+		inline vector_view<T>& vector_view<T>::operator=(const vector_view& oth)
+		{
+			return operator=<T>(oth);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline vector_view<T>& vector_view<T>::operator=(const vector_view<V>& oth)
+		{
+			assert(n == oth.size());
+			if (!aliases(storage(*this), oth))
+			{
+				std::copy(oth.begin(), oth.end(), begin());
+				return *this;
+			}
+
+			// same step: a destination ahead of the source is copied backwards
+			auto order = update_order(storage(*this), oth);
+			if (order > 0)
+				std::copy(oth.begin(), oth.end(), begin());
+			else if (order < 0)
+				for (auto i = int128_t(n) - 1; i >= 0; i--)
+					base[i * step] = oth.base[i * step];
+			else
+			{
+				vector_base<typing::remove_cv_t<V>> copy = oth;
+				std::copy(copy.base.begin(), copy.base.end(), begin());
+			}
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_view<T>& vector_view<T>::operator=(const vector_base<value_type>& vect)
+		{
+			assert(n == vect.size());
+			if (aliases(storage(*this), vect))
+				return *this = vector_view<const value_type>(vect.base.data(), vect.size());
+			std::copy(vect.base.begin(), vect.base.end(), begin());
+			return *this;
+		}
+
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline vector_view<T>& vector_view<T>::operator=(const vector_expr<L, R, Op>& expr)
+		{
+			assert(n == expr.size());
+			if (aliases(storage(*this), expr))
+			{
+				auto value = expr.eval();
+				for (int i = 0; i < n; i++)
+					(*this)[i] = value[i];
+				return *this;
+			}
+
+			for (int i = 0; i < n; i++)
+				(*this)[i] = expr[i];
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_view<T>& vector_view<T>::fill(const value_type& value)
+		{
+			std::fill(begin(), end(), value);
+			return *this;
+		}
+
+		template<typename T>
+		inline uint128_t vector_view<T>::size() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline T& vector_view<T>::operator[](int32_t i) const
+		{
+			if (i < 0)
+				return base[(int128_t(n) + i) * step];
+			return base[i * step];
+		}
+
+		template<typename T>
+		inline typename vector_view<T>::iterator vector_view<T>::begin() const
+		{
+			return iterator{ base, step };
+		}
+
+		template<typename T>
+		inline typename vector_view<T>::iterator vector_view<T>::end() const
+		{
+			return iterator{ base + int128_t(n) * step, step };
+		}
+
+		template<typename T>
+		inline vector_view<T> vector_view<T>::slice(int32_t beg, int32_t end, uint32_t step) const
+		{
+			int32_t st = step;
+			auto n = 1 + std::abs(end - beg) / st;
+			if (beg > end)
+				st = -st;
+			return vector_view<T>(&(*this)[beg], n, this->step * st);
+		}
+
+		template<typename T>
+		inline typename vector_view<T>::value_type vector_view<T>::max() const
+		{
+			return *std::max_element(begin(), end());
+		}
+
+		template<typename T>
+		inline typename vector_view<T>::value_type vector_view<T>::min() const
+		{
+			return *std::min_element(begin(), end());
+		}
+
+		template<typename T>
+		inline typename vector_view<T>::value_type vector_view<T>::sum() const
+		{
+			value_type sumv = 0;
+			for (auto& element : *this)
+				sumv += element;
+			return sumv;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline auto vector_view<T>::dot(const vector_view<V>& oth) const
+		{
+			using VV = typing::remove_cv_t<V>;
+			using TS = typing::conditional_t<typing::is_stronger<value_type, VV>::value, value_type, VV>;
+			assert(n == oth.size());
+			TS product = 0;
+			for (int i = 0; i < n; i++)
+				product += (*this)[i] * oth[i];
+			return product;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline auto vector_view<T>::dot(const vector_base<V>& oth) const
+		{
+			return dot(vector_view<const V>(oth.base.data(), oth.size()));
+		}
+
+		template<typename T>
+		template<typename V>
+		inline vector_view<T>& vector_view<T>::operator+=(const V& oth)
+		{
+			if constexpr (typing::is_arithmetic<V>::value || typing::is_complex<V>::value)
+			{
+				for (auto& element : *this)
+					element += oth;
+			}
+			else
+			{
+				assert(n == oth.size());
+				int32_t order = 1;
+				if constexpr (typing::is_vector_operand_v<V>)
+				{
+					auto dst = storage(*this);
+					if (aliases(dst, oth))
+						order = update_order(dst, oth);
+
+					// a copy even of vector_base, which overlaps a strided view
+					if (order == 0)
+						return *this += vector_base<typename V::value_type>(owning(oth));
+				}
+
+				if (order > 0)
+					for (int i = 0; i < n; i++)
+						(*this)[i] += oth[i];
+				else
+					for (auto i = int128_t(n) - 1; i >= 0; i--)
+						(*this)[i] += oth[i];
+			}
+			return *this;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline vector_view<T>& vector_view<T>::operator-=(const V& oth)
+		{
+			if constexpr (typing::is_arithmetic<V>::value || typing::is_complex<V>::value)
+			{
+				for (auto& element : *this)
+					element -= oth;
+			}
+			else
+			{
+				assert(n == oth.size());
+				int32_t order = 1;
+				if constexpr (typing::is_vector_operand_v<V>)
+				{
+					auto dst = storage(*this);
+					if (aliases(dst, oth))
+						order = update_order(dst, oth);
+
+					// a copy even of vector_base, which overlaps a strided view
+					if (order == 0)
+						return *this -= vector_base<typename V::value_type>(owning(oth));
+				}
+
+				if (order > 0)
+					for (int i = 0; i < n; i++)
+						(*this)[i] -= oth[i];
+				else
+					for (auto i = int128_t(n) - 1; i >= 0; i--)
+						(*this)[i] -= oth[i];
+			}
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_view<T>& vector_view<T>::operator*=(const value_type& value)
+		{
+			for (auto& element : *this)
+				element *= value;
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_view<T>& vector_view<T>::operator/=(const value_type& value)
+		{
+			for (auto& element : *this)
+				element /= value;
+			return *this;
+		}
+
+		template<typename T>
+		inline vector_view<T>::operator vector_base<value_type>() const
+		{
+			return vector_base<value_type>(std::vector<value_type>(begin(), end()));
+		}
+
+		template<typename T>
+		inline matrix_view<T>::matrix_view(T* ptr, uint128_t m, uint128_t n, int128_t rstep, int128_t cstep) :
+			base(ptr),
+			m(m),
+			n(n),
+			rstep(rstep),
+			cstep(cstep)
+		{
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_view<T>::matrix_view(const matrix_view<V>& oth) :
+			base(oth.base),
+			m(oth.m),
+			n(oth.n),
+			rstep(oth.rstep),
+			cstep(oth.cstep)
+		{
+		}
+
+		template<typename T>
+		inline matrix_view<T>& matrix_view<T>::operator=(const matrix_view& oth)
+		{
+			return operator=<T>(oth);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_view<T>& matrix_view<T>::operator=(const matrix_view<V>& oth)
+		{
+			assert(size() == oth.size());
+			if (aliases(storage(*this), oth))
+				return *this = matrix_base<value_type>(oth);
+			for (int i = 0; i < m; i++)
+				row(i) = oth.row(i);
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_view<T>& matrix_view<T>::operator=(const matrix_base<value_type>& matr)
+		{
+			assert(size() == matr.size());
+			if (aliases(storage(*this), matr))
+				return *this = matrix_base<value_type>(matr);
+			for (int i = 0; i < m; i++)
+				row(i) = matr.row(i);
+			return *this;
+		}
+
+		template<typename T>
+		template<typename L, typename R, typename Op>
+		inline matrix_view<T>& matrix_view<T>::operator=(const matrix_expr<L, R, Op>& expr)
+		{
+			assert(size() == expr.size());
+			if (aliases(storage(*this), expr))
+			{
+				auto value = expr.eval();
+				for (int i = 0; i < m; i++)
+					for (int j = 0; j < n; j++)
+						(*this)(i, j) = value(i, j);
+				return *this;
+			}
+
+			for (int i = 0; i < m; i++)
+				for (int j = 0; j < n; j++)
+					(*this)(i, j) = expr(i, j);
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_view<T>& matrix_view<T>::fill(const value_type& value)
+		{
+			for (int i = 0; i < m; i++)
+				row(i).fill(value);
+			return *this;
+		}
+
+		template<typename T>
+		inline uint128_t matrix_view<T>::rows() const
+		{
+			return m;
+		}
+
+		template<typename T>
+		inline uint128_t matrix_view<T>::cols() const
+		{
+			return n;
+		}
+
+		template<typename T>
+		inline std::pair<uint128_t, uint128_t> matrix_view<T>::size() const
+		{
+			return std::make_pair(m, n);
+		}
+
+		template<typename T>
+		inline T& matrix_view<T>::operator()(uint128_t i, uint128_t j) const
+		{
+			return base[int128_t(i) * rstep + int128_t(j) * cstep];
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_view<T>::row(int i) const
+		{
+			if (i < 0)
+				i = m + i;
+			return vector_view<T>(base + i * rstep, n, cstep);
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_view<T>::col(int i) const
+		{
+			if (i < 0)
+				i = n + i;
+			return vector_view<T>(base + i * cstep, m, rstep);
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_view<T>::diagonal(int i) const
+		{
+			auto k = i < 0 ? std::min<int128_t>(m + i, n) : std::min<int128_t>(m, n - i);
+			auto ptr = i < 0 ? base - i * rstep : base + i * cstep;
+			return vector_view<T>(ptr, k, rstep + cstep);
+		}
+
+		template<typename T>
+		inline vector_view<T> matrix_view<T>::operator[](int i) const
+		{
+			return row(i);
+		}
+
+		template<typename T>
+		inline matrix_view<T> matrix_view<T>::slice(int32_t rbeg, int32_t rend, int32_t cbeg, int32_t cend, uint32_t rstep, uint32_t cstep) const
+		{
+			int32_t rst = rstep;
+			int32_t cst = cstep;
+			auto m = 1 + std::abs(rend - rbeg) / rst;
+			auto n = 1 + std::abs(cend - cbeg) / cst;
+			if (rbeg > rend) rst = -rst;
+			if (cbeg > cend) cst = -cst;
+
+			return matrix_view<T>(&row(rbeg)[cbeg], m, n, this->rstep * rst, this->cstep * cst);
+		}
+
+		template<typename T>
+		inline matrix_view<T> matrix_view<T>::transposed() const
+		{
+			return matrix_view<T>(base, n, m, cstep, rstep);
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_view<T>& matrix_view<T>::operator+=(const V& oth)
+		{
+			if constexpr (typing::is_arithmetic<V>::value || typing::is_complex<V>::value)
+			{
+				for (int i = 0; i < m; i++)
+					row(i) += oth;
+			}
+			else
+			{
+				assert(size() == oth.size());
+				if constexpr (typing::is_matrix_operand_v<V>)
+					if (aliases(storage(*this), oth))
+						return *this += matrix_base<typename V::value_type>(owning(oth));
+				for (int i = 0; i < m; i++)
+					for (int j = 0; j < n; j++)
+						(*this)(i, j) += oth(i, j);
+			}
+			return *this;
+		}
+
+		template<typename T>
+		template<typename V>
+		inline matrix_view<T>& matrix_view<T>::operator-=(const V& oth)
+		{
+			if constexpr (typing::is_arithmetic<V>::value || typing::is_complex<V>::value)
+			{
+				for (int i = 0; i < m; i++)
+					row(i) -= oth;
+			}
+			else
+			{
+				assert(size() == oth.size());
+				if constexpr (typing::is_matrix_operand_v<V>)
+					if (aliases(storage(*this), oth))
+						return *this -= matrix_base<typename V::value_type>(owning(oth));
+				for (int i = 0; i < m; i++)
+					for (int j = 0; j < n; j++)
+						(*this)(i, j) -= oth(i, j);
+			}
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_view<T>& matrix_view<T>::operator*=(const value_type& value)
+		{
+			for (int i = 0; i < m; i++)
+				row(i) *= value;
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_view<T>& matrix_view<T>::operator/=(const value_type& value)
+		{
+			for (int i = 0; i < m; i++)
+				row(i) /= value;
+			return *this;
+		}
+
+		template<typename T>
+		inline matrix_view<T>::operator matrix_base<value_type>() const
+		{
+			matrix_base<value_type> result(m, n);
+			for (int i = 0; i < m; i++)
+				result.row(i) = row(i);
+			return result;
+		}
+	}
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::vector_view<T>& view)
+{
+	for (auto& elem : view)
+		out << elem << "\n";
+	out << typeid(view).name() << "\n";
+	return out;
+}
+
+template<typename T>
+inline std::ostream& operator<<(std::ostream& out, const nm::base_type::matrix_view<T>& view)
+{
+	auto [m, n] = view.size();
+	for (int i = 0; i < m; i++)
+	{
+		for (int j = 0; j < n; j++)
+			out << "\t" << view(i, j);
+		out << "\n";
+	}
+	out << typeid(view).name() << "\n";
+	return out;
+}